@@ -0,0 +1,422 @@
+/**
+ * @author Volodymyr Lotoshko (vlotoshko@gmail.com)
+ * @date 19-Oct-2026
+ */
+
+//--------------------------------------------------------------------------------------------------
+#ifndef B_PLUS_TREE_HPP
+#define B_PLUS_TREE_HPP
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+#include <algorithm>
+#include <utility>
+#include <vector>
+//--------------------------------------------------------------------------------------------------
+
+namespace bst // binary search tree
+{
+
+/**
+ * @class BPlusTree
+ * @brief The BPlusTree class is the ordered map which keeps many keys in every node, so the tree
+ * is shallow and searching inside the node goes through contiguous memory.
+ * @tparam Key key type of the tree
+ * @tparam Value value type of the tree
+ * @tparam Order max count of children of the inner node, by default keys of the node take
+ * two cache lines
+ *
+ * All items are kept in the leaves, inner nodes keep only separators: the separator is the
+ * minimal key of its right subtree. Leaves are linked into the list, so range scans walk leaves
+ * sequentially. Inner nodes keep sizes of their subtrees for rank and select. Keys inside the
+ * node are searched by counting the keys less than the given one without branches, such loop
+ * is vectorized by the compiler for arithmetic keys. Nodes which overflow by appending the largest
+ * key are split unevenly, so increasing keys (e.g. time series) fill the nodes completely.
+ * Key and Value must be default constructible.
+ */
+template<typename Key, typename Value, size_t Order = (128 / sizeof(Key) < 4 ? 4 : 128 / sizeof(Key))>
+class BPlusTree
+{
+    static_assert(Order >= 4, "BPlusTree: order must be at least 4");
+
+public:
+    /// @brief The BPlusTree default constructor.
+    BPlusTree() : root_(new Leaf), head_(static_cast<Leaf *>(root_)), size_(0), height_(1) {}
+    ~BPlusTree() { destroy_(root_); }
+
+    BPlusTree(const BPlusTree &) = delete;
+    BPlusTree & operator= (const BPlusTree &) = delete;
+
+    /// @brief Puts new element into the tree, replaces value of the existing key.
+    void put(Key k, Value v);
+
+    /// @brief Gets value by key, value-initialized value if key is absent.
+    Value get(const Key & k) const;
+
+    /// @brief Defines whether the tree contains the key.
+    bool contains(const Key & k) const;
+
+    /// @brief Returns count of elements in the tree.
+    size_t size() const { return size_; }
+
+    /// @brief Returns count of levels of the tree.
+    size_t height() const { return height_; }
+
+    /// @brief Gets the largest key not greater than given, nullptr if there is no such key.
+    const Key * floor(const Key & k) const;
+
+    /// @brief Gets the smallest key not less than given, nullptr if there is no such key.
+    const Key * ceiling(const Key & k) const;
+
+    /// @brief Gets the key by its rank, nullptr if rank is out of range.
+    const Key * select(size_t r) const;
+
+    /// @brief Gets the rank of the key: the count of keys less than given.
+    size_t rank(const Key & k) const;
+
+    /// @brief Returns sorted keys within lo-hi interval.
+    std::vector<Key> keys(const Key & lo, const Key & hi) const;
+
+    /// @brief Returns all keys sorted.
+    std::vector<Key> keys() const;
+
+    /**
+     * @brief Calls the function for every item within lo-hi interval in the order of keys.
+     * @param[in] lo low boundary of the interval
+     * @param[in] hi high boundary of the interval
+     * @param[in] f function called as f(key, value)
+     */
+    template<typename Function>
+    void forEach(const Key & lo, const Key & hi, Function f) const;
+
+private:
+    /// @brief Common part of the nodes, one slot more than stable count of keys for overflow
+    struct Node
+    {
+        explicit Node(bool l) : leaf(l), count(0), keys() {}
+        bool   leaf;
+        size_t count;
+        Key    keys[Order];
+    };
+
+    /// @brief Leaf keeps items and links to the neighbour leaves
+    struct Leaf : Node
+    {
+        Leaf() : Node(true), values(), prev(nullptr), next(nullptr) {}
+        Value values[Order];
+        Leaf * prev;
+        Leaf * next;
+    };
+
+    /// @brief Inner node keeps separators, children and sizes of the children subtrees
+    struct Inner : Node
+    {
+        Inner() : Node(false), children(), sizes() {}
+        Node * children[Order + 1];
+        size_t sizes[Order + 1];
+    };
+
+    /// @brief Result of the node split: separator and the new right node
+    struct Split
+    {
+        Key    key;
+        Node * right;
+    };
+
+    Node * root_;  // Root node of the tree
+    Leaf * head_;  // The leftmost leaf
+    size_t size_;  // Count of items
+    size_t height_; // Count of levels
+
+    /// @brief Count of the node keys less than k
+    static size_t lowerBound_(const Node * n, const Key & k);
+
+    /// @brief Count of the node keys not greater than k
+    static size_t upperBound_(const Node * n, const Key & k);
+
+    /// @brief Count of items in the subtree
+    static size_t subtreeSize_(const Node * n);
+
+    static void destroy_(Node * n);
+
+    const Leaf * findLeaf_(const Key & k) const;
+    bool insert_(Node * n, Key & k, Value & v, Split & split);
+    void splitLeaf_(Leaf * l, Split & split, bool append);
+    void splitInner_(Inner * in, Split & split, bool append);
+};
+
+// ----- BPlusTree -----
+
+template<typename Key, typename Value, size_t Order>
+void BPlusTree<Key, Value, Order>::put(Key k, Value v)
+{
+    Split split{Key{}, nullptr};
+    if (insert_(root_, k, v, split))
+        ++size_;
+
+    if (split.right != nullptr)
+    {
+        Inner * root = new Inner;
+        root->count = 1;
+        root->keys[0] = std::move(split.key);
+        root->children[0] = root_;
+        root->children[1] = split.right;
+        root->sizes[1] = subtreeSize_(split.right);
+        root->sizes[0] = size_ - root->sizes[1];
+        root_ = root;
+        ++height_;
+    }
+}
+
+template<typename Key, typename Value, size_t Order>
+Value BPlusTree<Key, Value, Order>::get(const Key & k) const
+{
+    const Leaf * l = findLeaf_(k);
+    size_t pos = lowerBound_(l, k);
+    return pos < l->count && l->keys[pos] == k ? l->values[pos] : Value{};
+}
+
+template<typename Key, typename Value, size_t Order>
+bool BPlusTree<Key, Value, Order>::contains(const Key & k) const
+{
+    const Leaf * l = findLeaf_(k);
+    size_t pos = lowerBound_(l, k);
+    return pos < l->count && l->keys[pos] == k;
+}
+
+template<typename Key, typename Value, size_t Order>
+const Key * BPlusTree<Key, Value, Order>::floor(const Key & k) const
+{
+    const Leaf * l = findLeaf_(k);
+    size_t pos = upperBound_(l, k);
+    if (pos > 0)
+        return &l->keys[pos - 1];
+
+    l = l->prev;
+    return l ? &l->keys[l->count - 1] : nullptr;
+}
+
+template<typename Key, typename Value, size_t Order>
+const Key * BPlusTree<Key, Value, Order>::ceiling(const Key & k) const
+{
+    const Leaf * l = findLeaf_(k);
+    size_t pos = lowerBound_(l, k);
+    if (pos < l->count)
+        return &l->keys[pos];
+
+    l = l->next;
+    return l ? &l->keys[0] : nullptr;
+}
+
+template<typename Key, typename Value, size_t Order>
+const Key * BPlusTree<Key, Value, Order>::select(size_t r) const
+{
+    if (r >= size_)
+        return nullptr;
+
+    const Node * n = root_;
+    while (!n->leaf)
+    {
+        auto in = static_cast<const Inner *>(n);
+        size_t i = 0;
+        while (r >= in->sizes[i])
+            r -= in->sizes[i++];
+        n = in->children[i];
+    }
+    return &n->keys[r];
+}
+
+template<typename Key, typename Value, size_t Order>
+size_t BPlusTree<Key, Value, Order>::rank(const Key & k) const
+{
+    size_t r = 0;
+    const Node * n = root_;
+    while (!n->leaf)
+    {
+        auto in = static_cast<const Inner *>(n);
+        size_t i = upperBound_(in, k);
+        for (size_t j = 0; j < i; ++j)
+            r += in->sizes[j];
+        n = in->children[i];
+    }
+    return r + lowerBound_(n, k);
+}
+
+template<typename Key, typename Value, size_t Order>
+std::vector<Key> BPlusTree<Key, Value, Order>::keys(const Key & lo, const Key & hi) const
+{
+    std::vector<Key> vec;
+    forEach(lo, hi, [&vec](const Key & k, const Value &) { vec.push_back(k); });
+    return vec;
+}
+
+template<typename Key, typename Value, size_t Order>
+std::vector<Key> BPlusTree<Key, Value, Order>::keys() const
+{
+    std::vector<Key> vec;
+    vec.reserve(size_);
+    for (const Leaf * l = head_; l != nullptr; l = l->next)
+        vec.insert(vec.end(), l->keys, l->keys + l->count);
+    return vec;
+}
+
+template<typename Key, typename Value, size_t Order>
+template<typename Function>
+void BPlusTree<Key, Value, Order>::forEach(const Key & lo, const Key & hi, Function f) const
+{
+    const Leaf * l = findLeaf_(lo);
+    for (size_t pos = lowerBound_(l, lo); l != nullptr; l = l->next, pos = 0)
+    {
+        for (; pos < l->count; ++pos)
+        {
+            if (hi < l->keys[pos])
+                return;
+            f(l->keys[pos], l->values[pos]);
+        }
+    }
+}
+
+template<typename Key, typename Value, size_t Order>
+size_t BPlusTree<Key, Value, Order>::lowerBound_(const Node * n, const Key & k)
+{
+    size_t pos = 0;
+    for (size_t i = 0; i < n->count; ++i)
+        pos += static_cast<size_t>(n->keys[i] < k);
+    return pos;
+}
+
+template<typename Key, typename Value, size_t Order>
+size_t BPlusTree<Key, Value, Order>::upperBound_(const Node * n, const Key & k)
+{
+    size_t pos = 0;
+    for (size_t i = 0; i < n->count; ++i)
+        pos += static_cast<size_t>(!(k < n->keys[i]));
+    return pos;
+}
+
+template<typename Key, typename Value, size_t Order>
+size_t BPlusTree<Key, Value, Order>::subtreeSize_(const Node * n)
+{
+    if (n->leaf)
+        return n->count;
+
+    auto in = static_cast<const Inner *>(n);
+    size_t size = 0;
+    for (size_t i = 0; i <= in->count; ++i)
+        size += in->sizes[i];
+    return size;
+}
+
+template<typename Key, typename Value, size_t Order>
+void BPlusTree<Key, Value, Order>::destroy_(Node * n)
+{
+    if (n->leaf)
+    {
+        delete static_cast<Leaf *>(n);
+        return;
+    }
+
+    auto in = static_cast<Inner *>(n);
+    for (size_t i = 0; i <= in->count; ++i)
+        destroy_(in->children[i]);
+    delete in;
+}
+
+template<typename Key, typename Value, size_t Order>
+const typename BPlusTree<Key, Value, Order>::Leaf * BPlusTree<Key, Value, Order>::findLeaf_(const Key & k) const
+{
+    const Node * n = root_;
+    while (!n->leaf)
+    {
+        auto in = static_cast<const Inner *>(n);
+        n = in->children[upperBound_(in, k)];
+    }
+    return static_cast<const Leaf *>(n);
+}
+
+template<typename Key, typename Value, size_t Order>
+bool BPlusTree<Key, Value, Order>::insert_(Node * n, Key & k, Value & v, Split & split)
+{
+    if (n->leaf)
+    {
+        auto l = static_cast<Leaf *>(n);
+        size_t pos = lowerBound_(l, k);
+        if (pos < l->count && l->keys[pos] == k)
+        {
+            l->values[pos] = std::move(v);
+            return false;
+        }
+
+        std::move_backward(l->keys + pos, l->keys + l->count, l->keys + l->count + 1);
+        std::move_backward(l->values + pos, l->values + l->count, l->values + l->count + 1);
+        l->keys[pos] = std::move(k);
+        l->values[pos] = std::move(v);
+        if (++l->count == Order)
+            splitLeaf_(l, split, l->next == nullptr && pos + 1 == l->count);
+        return true;
+    }
+
+    auto in = static_cast<Inner *>(n);
+    size_t i = upperBound_(in, k);
+    Split child{Key{}, nullptr};
+    bool inserted = insert_(in->children[i], k, v, child);
+    if (inserted)
+        ++in->sizes[i];
+
+    if (child.right != nullptr)
+    {
+        std::move_backward(in->keys + i, in->keys + in->count, in->keys + in->count + 1);
+        std::move_backward(in->children + i + 1, in->children + in->count + 1, in->children + in->count + 2);
+        std::move_backward(in->sizes + i + 1, in->sizes + in->count + 1, in->sizes + in->count + 2);
+        in->keys[i] = std::move(child.key);
+        in->children[i + 1] = child.right;
+        in->sizes[i + 1] = subtreeSize_(child.right);
+        in->sizes[i] -= in->sizes[i + 1];
+        if (++in->count == Order)
+            splitInner_(in, split, i + 1 == in->count);
+    }
+    return inserted;
+}
+
+template<typename Key, typename Value, size_t Order>
+void BPlusTree<Key, Value, Order>::splitLeaf_(Leaf * l, Split & split, bool append)
+{
+    // appending of increasing keys leaves full nodes behind, otherwise nodes are split in halves
+    Leaf * r = new Leaf;
+    size_t half = append ? l->count - 1 : l->count / 2;
+    r->count = l->count - half;
+    std::move(l->keys + half, l->keys + l->count, r->keys);
+    std::move(l->values + half, l->values + l->count, r->values);
+    l->count = half;
+
+    r->next = l->next;
+    r->prev = l;
+    if (l->next != nullptr)
+        l->next->prev = r;
+    l->next = r;
+
+    split.key = r->keys[0];
+    split.right = r;
+}
+
+template<typename Key, typename Value, size_t Order>
+void BPlusTree<Key, Value, Order>::splitInner_(Inner * in, Split & split, bool append)
+{
+    // the middle key goes up, keys after it move to the new node
+    Inner * r = new Inner;
+    size_t mid = append ? in->count - 2 : in->count / 2;
+    r->count = in->count - mid - 1;
+    std::move(in->keys + mid + 1, in->keys + in->count, r->keys);
+    std::copy(in->children + mid + 1, in->children + in->count + 1, r->children);
+    std::copy(in->sizes + mid + 1, in->sizes + in->count + 1, r->sizes);
+    in->count = mid;
+
+    split.key = std::move(in->keys[mid]);
+    split.right = r;
+}
+
+} // namespace bst
+
+//--------------------------------------------------------------------------------------------------
+#endif // B_PLUS_TREE_HPP
+//--------------------------------------------------------------------------------------------------
@@ -0,0 +1,104 @@
+/**
+ * @author Volodymyr Lotoshko (vlotoshko@gmail.com)
+ * @date 19-Oct-2026
+ */
+
+//--------------------------------------------------------------------------------------------------
+#ifndef BST_AGGREGATES_HPP
+#define BST_AGGREGATES_HPP
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+#include <algorithm>
+#include <limits>
+//--------------------------------------------------------------------------------------------------
+
+namespace bst // binary search tree
+{
+
+/**
+ * @struct NoAggregate
+ * @brief The NoAggregate template struct is the aggregate policy of the tree without aggregates,
+ * nodes of such tree keep no extra data.
+ * @tparam Value value type of the tree
+ *
+ * Aggregate policy is the monoid over the values: Type is the type of the aggregate, identity()
+ * is the neutral element, of(value) makes the aggregate of one value and combine(a, b) joins
+ * aggregates of the adjacent key ranges, a goes before b.
+ */
+template<typename Value>
+struct NoAggregate
+{
+    struct Type {};
+};
+
+/**
+ * @struct SumAggregate
+ * @brief The SumAggregate template struct is the aggregate policy which keeps sum of the values.
+ * @tparam Value value type of the tree
+ */
+template<typename Value>
+struct SumAggregate
+{
+    using Type = Value;
+    static Type identity() { return Type{}; }
+    static Type of(const Value & v) { return v; }
+    static Type combine(const Type & a, const Type & b) { return a + b; }
+};
+
+/**
+ * @struct MinAggregate
+ * @brief The MinAggregate template struct is the aggregate policy which keeps minimal value.
+ * @tparam Value value type of the tree
+ */
+template<typename Value>
+struct MinAggregate
+{
+    using Type = Value;
+    static Type identity() { return std::numeric_limits<Value>::max(); }
+    static Type of(const Value & v) { return v; }
+    static Type combine(const Type & a, const Type & b) { return std::min(a, b); }
+};
+
+/**
+ * @struct MaxAggregate
+ * @brief The MaxAggregate template struct is the aggregate policy which keeps maximal value.
+ * @tparam Value value type of the tree
+ */
+template<typename Value>
+struct MaxAggregate
+{
+    using Type = Value;
+    static Type identity() { return std::numeric_limits<Value>::lowest(); }
+    static Type of(const Value & v) { return v; }
+    static Type combine(const Type & a, const Type & b) { return std::max(a, b); }
+};
+
+/**
+ * @struct AggregateField
+ * @brief The AggregateField template struct is the base of the tree node which keeps aggregate
+ * of the node subtree.
+ * @tparam Aggregate aggregate policy
+ */
+template<typename Aggregate>
+struct AggregateField
+{
+    AggregateField() : agg(Aggregate::identity()) {}
+    typename Aggregate::Type agg;
+};
+
+/**
+ * @struct AggregateField
+ * @brief The AggregateField specialization for the tree without aggregates is empty, so it takes
+ * no memory in the node.
+ */
+template<typename Value>
+struct AggregateField<NoAggregate<Value>>
+{
+};
+
+} // namespace bst
+
+//--------------------------------------------------------------------------------------------------
+#endif // BST_AGGREGATES_HPP
+//--------------------------------------------------------------------------------------------------
@@ -11,6 +11,9 @@
 //--------------------------------------------------------------------------------------------------
 #include <iostream>
 #include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
 #include <vector>
 //--------------------------------------------------------------------------------------------------
 
@@ -40,14 +43,16 @@ size_t ObjectCounter::count = 0;
 template<typename Node>
 Node* get(Node * n,  typename Node::KeyType k)
 {
-    if(n == nullptr)
-        return nullptr;
-
-    if (k < n->key)
-        return get(n->left, k);
-    if (k > n->key)
-        return get(n->right, k);
-    return n;
+    while (n != nullptr)
+    {
+        if (k < n->key)
+            n = n->left;
+        else if (k > n->key)
+            n = n->right;
+        else
+            return n;
+    }
+    return nullptr;
 }
 
 /**
@@ -58,10 +63,9 @@ Node* get(Node * n,  typename Node::KeyType k)
 template<typename Node>
 Node* min(Node * n)
 {
-    if (n->left)
-        return min(n->left);
-    else
-        return n;
+    while (n->left)
+        n = n->left;
+    return n;
 }
 
 /**
@@ -72,10 +76,101 @@ Node* min(Node * n)
 template<typename Node>
 Node* max(Node * n)
 {
-    if (n->right)
-        return max(n->right);
-    else
-        return n;
+    while (n->right)
+        n = n->right;
+    return n;
+}
+
+/**
+ * @class InorderIterator
+ * @brief The InorderIterator class is the bidirectional iterator over the nodes of the tree in
+ * the order of their keys.
+ * @tparam Node node type
+ *
+ * Nodes have no links to their parents, so the iterator keeps only the root and the current
+ * node, it never allocates. When the next node is not in the subtree of the current one, it is
+ * the last node on the search path of the current key where the search turned left, so every
+ * step takes O(height) time. The end iterator has no current node.
+ */
+template<typename Node>
+class InorderIterator
+{
+public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = typename std::remove_const<Node>::type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type *;
+    using reference = const value_type &;
+
+    /// @brief Creates the end iterator of the tree.
+    explicit InorderIterator(Node * root = nullptr) : root_(root), node_(nullptr) {}
+
+    /// @brief Creates the iterator which points to the first node with key not less than k
+    /// (or greater than k if strict is true).
+    InorderIterator(Node * root, const typename Node::KeyType & k, bool strict);
+
+    reference operator* () const { return *node_; }
+    pointer operator-> () const { return node_; }
+
+    InorderIterator & operator++ ();
+    InorderIterator & operator-- ();
+    InorderIterator operator++ (int) { InorderIterator t = *this; ++*this; return t; }
+    InorderIterator operator-- (int) { InorderIterator t = *this; --*this; return t; }
+
+    bool operator== (const InorderIterator & other) const { return node_ == other.node_; }
+    bool operator!= (const InorderIterator & other) const { return node_ != other.node_; }
+
+    /// @brief Creates the iterator which points to the node with minimal key.
+    static InorderIterator first(Node * root);
+
+private:
+    Node * root_;
+    Node * node_; // Current node, nullptr for the end
+};
+
+/**
+ * @class InorderRange
+ * @brief The InorderRange class is the lazy range of the tree nodes, nodes are visited one by one
+ * while iterating over the range.
+ * @tparam Node node type
+ */
+template<typename Node>
+class InorderRange
+{
+public:
+    InorderRange(InorderIterator<Node> b, InorderIterator<Node> e) : begin_(std::move(b)), end_(std::move(e)) {}
+    const InorderIterator<Node> & begin() const { return begin_; }
+    const InorderIterator<Node> & end() const { return end_; }
+
+private:
+    InorderIterator<Node> begin_;
+    InorderIterator<Node> end_;
+};
+
+/**
+ * @brief Returns range of all nodes of the tree.
+ * @param[in] n root of the tree
+ * @return range of all nodes in the order of keys.
+ */
+template<typename Node>
+InorderRange<Node> range(Node * n)
+{
+    return InorderRange<Node>(InorderIterator<Node>::first(n), InorderIterator<Node>(n));
+}
+
+/**
+ * @brief Returns range of the nodes within lo-hi interval.
+ * @param[in] n root of the tree
+ * @param[in] lo low boundary of the interval
+ * @param[in] hi high boundary of the interval
+ * @return range of the nodes in the order of keys.
+ */
+template<typename Node>
+InorderRange<Node> range(Node * n, typename Node::KeyType lo, typename Node::KeyType hi)
+{
+    if (hi < lo)
+        return InorderRange<Node>(InorderIterator<Node>(n), InorderIterator<Node>(n));
+    return InorderRange<Node>(InorderIterator<Node>(n, lo, false), InorderIterator<Node>(n, hi, true));
 }
 
 /**
@@ -86,16 +181,9 @@ Node* max(Node * n)
 template<typename Node>
 typename Node::ValueType valueSum(Node * n)
 {
-    if (n == nullptr)
-        return 0;
-
     typename Node::ValueType i{};
-    if (n->left)
-        i += valueSum(n->left);
-    if (n->right)
-        i += valueSum(n->right);
-
-    i += n->val;
+    for (const auto & node : range(n))
+        i += node.val;
     return i;
 }
 
@@ -108,17 +196,21 @@ typename Node::ValueType valueSum(Node * n)
 template<typename Node>
 Node* floor(Node * n, typename Node::KeyType k)
 {
-    if (n == nullptr)
-        return nullptr;
-
-    if (n->key == k)
-        return n;
-
-    if (n->key > k)
-        return floor(n->left, k);
+    Node* t = nullptr;
+    while (n != nullptr)
+    {
+        if (n->key == k)
+            return n;
 
-    Node* t = floor(n->right, k);
-    return t ? t : n;
+        if (n->key > k)
+            n = n->left;
+        else
+        {
+            t = n;
+            n = n->right;
+        }
+    }
+    return t;
 }
 
 /**
@@ -130,17 +222,32 @@ Node* floor(Node * n, typename Node::KeyType k)
 template<typename Node>
 Node* ceiling(Node * n, typename Node::KeyType k)
 {
-    if (n == nullptr)
-        return nullptr;
-
-    if (n->key == k)
-        return n;
+    Node* t = nullptr;
+    while (n != nullptr)
+    {
+        if (n->key == k)
+            return n;
 
-    if (n->key < k)
-        return ceiling(n->right, k);
+        if (n->key < k)
+            n = n->right;
+        else
+        {
+            t = n;
+            n = n->left;
+        }
+    }
+    return t;
+}
 
-    Node* t = ceiling(n->left, k);
-    return t ? t : n;
+/**
+ * @brief Returns size of the tree.
+ * @param[in] n root of the tree
+ * @return size of the tree.
+ */
+template<typename Node>
+size_t size(Node * n)
+{
+    return n ? n->size : 0;
 }
 
 /**
@@ -154,18 +261,21 @@ Node* ceiling(Node * n, typename Node::KeyType k)
 template<typename Node>
 Node* select(Node * n, size_t r)
 {
-    if (n == nullptr)
-        return nullptr;
-
-    size_t t = size(n->left);
-
-    if (t > r)
-        return select(n->left, r);
-    else
-        if (t < r)
-            return select(n->right, r - t - 1);
+    while (n != nullptr)
+    {
+        size_t t = size(n->left);
+
+        if (t > r)
+            n = n->left;
+        else if (t < r)
+        {
+            r -= t + 1;
+            n = n->right;
+        }
         else
             return n;
+    }
+    return nullptr;
 }
 
 /**
@@ -179,45 +289,49 @@ Node* select(Node * n, size_t r)
 template<typename Node>
 size_t rank(Node * n, typename Node::KeyType k)
 {
-    if (n == nullptr)
-        return 0;
-
-    if (k < n->key)
-        return rank(n->left, k);
-    else
-        if (k > n->key)
-            return 1 + size(n->left) + rank(n->right, k);
+    size_t r = 0;
+    while (n != nullptr)
+    {
+        if (k < n->key)
+            n = n->left;
+        else if (k > n->key)
+        {
+            r += 1 + size(n->left);
+            n = n->right;
+        }
         else
-            return size(n->left);
-}
-
-/**
- * @brief Returns size of the tree.
- * @param[in] n root of the tree
- * @return size of the tree.
- */
-template<typename Node>
-size_t size(Node * n)
-{
-    return n ? n->size : 0;
+            return r + size(n->left);
+    }
+    return r;
 }
 
 /**
  * @brief Clears the tree.
  * @param[in] n root of the tree
+ * @param[in] alloc allocator which created the nodes
+ *
+ * Left children are rotated up until the node has no left child, then the node is destroyed and
+ * its right child is processed. So no stack is needed even for degenerate trees.
  */
-template<typename Node>
-void clear(Node * n)
+template<typename Node, typename Allocator>
+void clear(Node * n, Allocator & alloc)
 {
-    if (n == nullptr)
-        return;
-
-    if (n->left)
-        clear(n->left);
-    if (n->right)
-        clear(n->right);
-
-    delete n;
+    while (n != nullptr)
+    {
+        if (n->left)
+        {
+            Node * l = n->left;
+            n->left = l->right;
+            l->right = n;
+            n = l;
+        }
+        else
+        {
+            Node * r = n->right;
+            alloc.destroy(n);
+            n = r;
+        }
+    }
 }
 
 /**
@@ -227,12 +341,8 @@ void clear(Node * n)
 template<typename Node>
 void print(Node * n)
 {
-    if (n == nullptr)
-        return;
-
-    print(n->left);
-    std::cout << n->key << " ";
-    print(n->right);
+    for (const auto & node : range(n))
+        std::cout << node.key << " ";
 }
 
 /**
@@ -242,19 +352,92 @@ void print(Node * n)
  * @param[in] hi high boundary of the interval
  */
 template<typename Node>
-void keys(Node * n, std::vector<typename Node::Key>& v, typename Node::Key lo, typename Node::Key hi)
+void keys(Node * n, std::vector<typename Node::KeyType>& v, typename Node::KeyType lo, typename Node::KeyType hi)
+{
+    for (const auto & node : range(n, lo, hi))
+        v.push_back(node.key);
+}
+
+// ----- InorderIterator -----
+
+template<typename Node>
+InorderIterator<Node>::InorderIterator(Node * root, const typename Node::KeyType & k, bool strict)
+    : root_(root), node_(nullptr)
 {
-    if (n == nullptr)
-        return;
+    // the last node where the search turned left is the answer
+    for (Node * n = root; n != nullptr; )
+    {
+        if (strict ? k < n->key : !(n->key < k))
+        {
+            node_ = n;
+            n = n->left;
+        }
+        else
+            n = n->right;
+    }
+}
 
-    if (n->key >= lo)
-        keys(n->left, v, lo, hi);
+template<typename Node>
+InorderIterator<Node> InorderIterator<Node>::first(Node * root)
+{
+    InorderIterator it(root);
+    it.node_ = root != nullptr ? min(root) : nullptr;
+    return it;
+}
 
-    if (n->key >= lo && n->key <= hi)
-        v.push_back(n->key);
+template<typename Node>
+InorderIterator<Node> & InorderIterator<Node>::operator++ ()
+{
+    if (node_->right != nullptr)
+    {
+        node_ = min(node_->right);
+        return *this;
+    }
+
+    // the last node where the search of the current key turned left
+    Node * next = nullptr;
+    for (Node * n = root_; n != node_; )
+    {
+        if (node_->key < n->key)
+        {
+            next = n;
+            n = n->left;
+        }
+        else
+            n = n->right;
+    }
+    node_ = next;
+    return *this;
+}
 
-    if (n->key <= hi)
-        keys(n->right, v, lo, hi);
+template<typename Node>
+InorderIterator<Node> & InorderIterator<Node>::operator-- ()
+{
+    if (node_ == nullptr)
+    {
+        node_ = root_ != nullptr ? max(root_) : nullptr;
+        return *this;
+    }
+    if (node_->left != nullptr)
+    {
+        node_ = max(node_->left);
+        return *this;
+    }
+
+    // the last node where the search of the current key turned right
+    Node * prev = nullptr;
+    for (Node * n = root_; n != node_; )
+    {
+        if (node_->key < n->key)
+            n = n->left;
+        else
+        {
+            prev = n;
+            n = n->right;
+        }
+    }
+    node_ = prev;
+    return *this;
 }
 
 } // namespace bst
@@ -0,0 +1,147 @@
+/**
+ * @author Volodymyr Lotoshko (vlotoshko@gmail.com)
+ * @date 19-Oct-2026
+ */
+
+//--------------------------------------------------------------------------------------------------
+#ifndef BST_NODE_ALLOCATORS_HPP
+#define BST_NODE_ALLOCATORS_HPP
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+#include <algorithm>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+//--------------------------------------------------------------------------------------------------
+
+namespace bst // binary search tree
+{
+
+/**
+ * @class NodeHeap
+ * @brief The NodeHeap template class is the node allocation policy which allocates every node
+ * separately with new/delete.
+ * @tparam Node node type
+ */
+template<typename Node>
+class NodeHeap
+{
+public:
+    /// true if release frees memory of all nodes at once
+    static const bool RELEASES_ALL = false;
+
+    /// @brief Creates new node with the given constructor arguments.
+    template<typename... Args>
+    Node * create(Args &&... args) { return new Node(std::forward<Args>(args)...); }
+
+    /// @brief Destroys the node and frees its memory.
+    void destroy(Node * n) { delete n; }
+
+    /// @brief Nodes are freed one by one by destroy, so nothing to do here.
+    void release() {}
+};
+
+
+/**
+ * @class NodePool
+ * @brief The NodePool template class is the node allocation policy which places nodes into
+ * contiguous slabs.
+ * @tparam Node node type
+ *
+ * Allocation is a pointer bump inside the current slab, slabs grow twice up to MAX_SLAB nodes.
+ * Destroyed nodes are kept in the free list and reused first. Release frees all slabs at once,
+ * so a tree of trivially destructible nodes is torn down without visiting its nodes.
+ */
+template<typename Node>
+class NodePool
+{
+public:
+    /// true if release frees memory of all nodes at once
+    static const bool RELEASES_ALL = true;
+
+    /// @brief Count of nodes in the first slab and max count of nodes in one slab
+    enum : size_t { MIN_SLAB = 64, MAX_SLAB = 1 << 16 };
+
+    NodePool() : slabs_(), next_(nullptr), end_(nullptr), free_(nullptr), slabSize_(MIN_SLAB), capacity_(0) {}
+    ~NodePool() { release(); }
+
+    NodePool(const NodePool &) = delete;
+    NodePool & operator= (const NodePool &) = delete;
+
+    /// @brief Creates new node with the given constructor arguments.
+    template<typename... Args>
+    Node * create(Args &&... args)
+    {
+        Slot * slot = free_;
+        if (slot != nullptr)
+        {
+            free_ = slot->next;
+        }
+        else
+        {
+            if (next_ == end_)
+            {
+                grow();
+            }
+            slot = next_++;
+        }
+        return new (slot) Node(std::forward<Args>(args)...);
+    }
+
+    /// @brief Destroys the node and puts its memory into the free list.
+    void destroy(Node * n)
+    {
+        n->~Node();
+        Slot * slot = reinterpret_cast<Slot *>(n);
+        slot->next = free_;
+        free_ = slot;
+    }
+
+    /// @brief Frees all slabs. Nodes which are not trivially destructible must be destroyed before.
+    void release()
+    {
+        for (auto slab : slabs_)
+        {
+            delete [] slab;
+        }
+        slabs_.clear();
+        next_ = end_ = free_ = nullptr;
+        slabSize_ = MIN_SLAB;
+        capacity_ = 0;
+    }
+
+    /// @brief Returns count of nodes which fit into the allocated slabs.
+    size_t capacity() const { return capacity_; }
+
+private:
+    /// @brief Memory of one node, or link of the free list
+    union Slot
+    {
+        Slot * next;
+        typename std::aligned_storage<sizeof(Node), alignof(Node)>::type storage;
+    };
+
+    void grow()
+    {
+        slabs_.push_back(new Slot[slabSize_]);
+        next_ = slabs_.back();
+        end_ = next_ + slabSize_;
+        capacity_ += slabSize_;
+        slabSize_ = std::min<size_t>(slabSize_ * 2, MAX_SLAB);
+    }
+
+    std::vector<Slot *> slabs_;
+    Slot * next_;
+    Slot * end_;
+    Slot * free_;
+    size_t slabSize_;
+    size_t capacity_;
+};
+
+} // namespace bst
+
+//--------------------------------------------------------------------------------------------------
+#endif // BST_NODE_ALLOCATORS_HPP
+//--------------------------------------------------------------------------------------------------
@@ -9,7 +9,16 @@
 //--------------------------------------------------------------------------------------------------
 
 //--------------------------------------------------------------------------------------------------
+#include "BstAggregates.hpp"
 #include "BstHelperFunctions.hpp"
+#include "BstNodeAllocators.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
 //--------------------------------------------------------------------------------------------------
 
 namespace bst // binary search tree
@@ -20,16 +29,29 @@ namespace bst // binary search tree
  * @brief The RedBlackBST class is the balanced implementation of binary tree structure
  * @tparam Key key type of the tree
  * @tparam Value value type of the tree
+ * @tparam NodeAllocator node allocation policy, NodePool or NodeHeap
+ * @tparam Aggregate aggregate policy, every node keeps the aggregate of its subtree values,
+ * e.g. SumAggregate, MinAggregate, MaxAggregate or user defined monoid
  */
-template<typename Key, typename Value>
+template<typename Key, typename Value, template<typename> class NodeAllocator = NodePool,
+         typename Aggregate = NoAggregate<Value>>
 class BstRedBlack
 {
+    struct Node;
+
 public:
     enum class Color{ RED, BLACK };
+    using Iterator = InorderIterator<Node>;
 
     /// @brief The BstRedBlack default constructor..
-    BstRedBlack() : root_(nullptr) {}
-    ~BstRedBlack() { bst::clear(root_); }
+    BstRedBlack() : root_(nullptr), nodes_() {}
+    ~BstRedBlack() { clear(); }
+
+    BstRedBlack(const BstRedBlack &) = delete;
+    BstRedBlack & operator= (const BstRedBlack &) = delete;
+
+    /// @brief Deletes all elements of the tree.
+    void clear();
 
     /// @brief Puts new element into the tree.
     void put(Key k, Value v) { root_ = put_(root_, k, v);  root_->color = Color::BLACK; }
@@ -38,10 +60,52 @@ public:
     Value get(Key k) const { Node * n = bst::get(root_, k); return n ? n->val : typename Node::ValueType{}; }
 
     /// @brief Deletes element with the given key.
-    void deleteNode(Key k) { root_ = deleteNode_(root_, k); }
+    void deleteNode(Key k);
+
+    /// @brief Deletes element with the minimal key.
+    void deleteMin();
+
+    /// @brief Deletes element with the maximal key.
+    void deleteMax();
+
+    /// @brief Returns count of elements in the tree.
+    size_t size() const { return bst::size(root_); }
+
+    /// @brief Returns iterator to the node with minimal key.
+    Iterator begin() const { return Iterator::first(root_); }
+
+    /// @brief Returns iterator past the node with maximal key.
+    Iterator end() const { return Iterator(root_); }
+
+    /// @brief Returns lazy range of the nodes within lo-hi interval.
+    InorderRange<Node> range(Key lo, Key hi) const { return bst::range(root_, lo, hi); }
+
+    /**
+     * @brief Replaces content of the tree with the items of the sorted range in O(n) time.
+     * @param[in] first begin of the range of key/value pairs sorted by strictly increasing keys
+     * @param[in] last end of the range
+     * @throw std::invalid_argument if keys are not strictly increasing.
+     *
+     * The range is treated as the leaves of 2-3 tree with the smallest possible height: every node
+     * becomes 2-node if its subtrees can hold the rest of items, otherwise 3-node, which is black
+     * node with red left child. So the tree is balanced without rotations.
+     */
+    template<typename ForwardIt>
+    void build(ForwardIt first, ForwardIt last);
+
+    /// @brief Returns aggregate of all values of the tree.
+    typename Aggregate::Type aggregate() const { return root_ ? root_->agg : Aggregate::identity(); }
+
+    /**
+     * @brief Returns aggregate of the values with keys within lo-hi interval in O(log n) time.
+     * @param[in] lo low boundary of the interval
+     * @param[in] hi high boundary of the interval
+     * @return aggregate of the values, identity if there are no such keys.
+     */
+    typename Aggregate::Type aggregate(Key lo, Key hi) const;
 
 private:
-    struct Node //: public ObjectCounter
+    struct Node : public AggregateField<Aggregate>
     {
         using KeyType = Key;
         using ValueType = Value;
@@ -58,25 +122,57 @@ private:
     static size_t size_(Node * n);
 
     Node* root_; // Root node of the binary search tree
+    NodeAllocator<Node> nodes_; // Allocator of the tree nodes
 
     Node*  put_(Node * n, Key k, Value v);
     Node*  deleteNode_(Node * n, Key k);
+    Node*  deleteMin_(Node * n);
+    Node*  deleteMax_(Node * n);
     Node*  forgetMin_(Node * n);
 
+    template<typename ForwardIt>
+    Node*  build_(ForwardIt & it, size_t count, unsigned height);
+    static size_t maxCount_(unsigned height);
+
     bool   isRed_(const Node * n) const;
     Node*  rotateLeft_(Node * n);
     Node*  rotateRight_(Node * n);
     void   flipColors_(Node * n);
+    Node*  moveRedLeft_(Node * n);
+    Node*  moveRedRight_(Node * n);
+    Node*  balance_(Node * n);
+
+    /// @brief Recalculates size and aggregate of the node from its children.
+    void   update_(Node * n) { n->size = bst::size(n->left) + bst::size(n->right) + 1; updateAggregate_(n, HasAggregate{}); }
+    void   updateAggregate_(Node * n, std::true_type);
+    void   updateAggregate_(Node *, std::false_type) {}
+    using HasAggregate = std::integral_constant<bool, !std::is_same<Aggregate, NoAggregate<Value>>::value>;
+
+    typename Aggregate::Type aggregate_(const Node * n, const Key & lo, const Key & hi,
+                                        bool lowBounded, bool highBounded) const;
 
-    template<typename K, typename V>
-    friend bool testRbNodeIsRed(const BstRedBlack<K, V> & bst, K k);
+    template<typename K, typename V, template<typename> class A, typename G>
+    friend bool testRbNodeIsRed(const BstRedBlack<K, V, A, G> & bst, K k);
+
+    template<typename K, typename V, template<typename> class A, typename G>
+    friend bool testRbIsBalanced(const BstRedBlack<K, V, A, G> & bst);
 };
 
-template<typename Key, typename Value>
-typename BstRedBlack<Key, Value>::Node* BstRedBlack<Key, Value>::put_(Node * n,  Key k, Value v)
+template<typename Key, typename Value, template<typename> class NodeAllocator, typename Aggregate>
+void BstRedBlack<Key, Value, NodeAllocator, Aggregate>::clear()
+{
+    // pool frees trivially destructible nodes all at once without visiting them
+    if (!NodeAllocator<Node>::RELEASES_ALL || !std::is_trivially_destructible<Node>::value)
+        bst::clear(root_, nodes_);
+    nodes_.release();
+    root_ = nullptr;
+}
+
+template<typename Key, typename Value, template<typename> class NodeAllocator, typename Aggregate>
+typename BstRedBlack<Key, Value, NodeAllocator, Aggregate>::Node* BstRedBlack<Key, Value, NodeAllocator, Aggregate>::put_(Node * n,  Key k, Value v)
 {
     if(n == nullptr)
-        n = new Node(k, v, Color::RED);
+        n = nodes_.create(k, v, Color::RED);
 
     if (k < n->key)
         n->left = put_(n->left, k, v);
@@ -95,78 +191,366 @@ typename BstRedBlack<Key, Value>::Node* BstRedBlack<Key, Value>::put_(Node * n,
     if(isRed_(n->left) && isRed_(n->right))
         flipColors_(n);
 
-    n->size = (n->left ? n->left->size : 0) + (n->right ? n->right->size : 0) + 1;
+    update_(n);
+    return n;
+}
+
+template<typename Key, typename Value, template<typename> class NodeAllocator, typename Aggregate>
+void BstRedBlack<Key, Value, NodeAllocator, Aggregate>::deleteNode(Key k)
+{
+    if (bst::get(root_, k) == nullptr)
+        return;
+
+    // root is made red, so the deleted node is guaranteed to be not a 2-node
+    if (!isRed_(root_->left) && !isRed_(root_->right))
+        root_->color = Color::RED;
+
+    root_ = deleteNode_(root_, k);
+    if (root_ != nullptr)
+        root_->color = Color::BLACK;
+}
+
+template<typename Key, typename Value, template<typename> class NodeAllocator, typename Aggregate>
+void BstRedBlack<Key, Value, NodeAllocator, Aggregate>::deleteMin()
+{
+    if (root_ == nullptr)
+        return;
+
+    if (!isRed_(root_->left) && !isRed_(root_->right))
+        root_->color = Color::RED;
+
+    root_ = deleteMin_(root_);
+    if (root_ != nullptr)
+        root_->color = Color::BLACK;
+}
+
+template<typename Key, typename Value, template<typename> class NodeAllocator, typename Aggregate>
+void BstRedBlack<Key, Value, NodeAllocator, Aggregate>::deleteMax()
+{
+    if (root_ == nullptr)
+        return;
+
+    if (!isRed_(root_->left) && !isRed_(root_->right))
+        root_->color = Color::RED;
+
+    root_ = deleteMax_(root_);
+    if (root_ != nullptr)
+        root_->color = Color::BLACK;
+}
+
+template<typename Key, typename Value, template<typename> class NodeAllocator, typename Aggregate>
+template<typename ForwardIt>
+void BstRedBlack<Key, Value, NodeAllocator, Aggregate>::build(ForwardIt first, ForwardIt last)
+{
+    using Item = typename std::iterator_traits<ForwardIt>::value_type;
+    if (std::adjacent_find(first, last, [](const Item & a, const Item & b) { return !(a.first < b.first); }) != last)
+        throw std::invalid_argument("BstRedBlack::build: keys are not strictly increasing");
+
+    clear();
+
+    size_t count = static_cast<size_t>(std::distance(first, last));
+    unsigned height = 0;
+    while (height < 63 && (static_cast<size_t>(1) << (height + 1)) - 1 <= count)
+        ++height;
+
+    root_ = build_(first, count, height);
+}
+
+template<typename Key, typename Value, template<typename> class NodeAllocator, typename Aggregate>
+typename BstRedBlack<Key, Value, NodeAllocator, Aggregate>::Node* BstRedBlack<Key, Value, NodeAllocator, Aggregate>::deleteNode_(Node * n,  Key k)
+{
+    if (k < n->key)
+    {
+        if (!isRed_(n->left) && !isRed_(n->left->left))
+            n = moveRedLeft_(n);
+        n->left = deleteNode_(n->left, k);
+    }
+    else
+    {
+        if (isRed_(n->left))
+            n = rotateRight_(n);
+
+        if (k == n->key && n->right == nullptr)
+        {
+            nodes_.destroy(n);
+            return nullptr;
+        }
+
+        if (!isRed_(n->right) && !isRed_(n->right->left))
+            n = moveRedRight_(n);
+
+        if (k == n->key)
+        {
+            // replace the node by its successor, which is then deleted from the right subtree
+            Node * t = bst::min(n->right);
+            n->key = std::move(t->key);
+            n->val = std::move(t->val);
+            n->right = deleteMin_(n->right);
+        }
+        else
+            n->right = deleteNode_(n->right, k);
+    }
+    return balance_(n);
+}
+
+template<typename Key, typename Value, template<typename> class NodeAllocator, typename Aggregate>
+typename BstRedBlack<Key, Value, NodeAllocator, Aggregate>::Node* BstRedBlack<Key, Value, NodeAllocator, Aggregate>::deleteMin_(Node * n)
+{
+    if (n->left == nullptr)
+    {
+        nodes_.destroy(n);
+        return nullptr;
+    }
+
+    if (!isRed_(n->left) && !isRed_(n->left->left))
+        n = moveRedLeft_(n);
+
+    n->left = deleteMin_(n->left);
+    return balance_(n);
+}
+
+template<typename Key, typename Value, template<typename> class NodeAllocator, typename Aggregate>
+typename BstRedBlack<Key, Value, NodeAllocator, Aggregate>::Node* BstRedBlack<Key, Value, NodeAllocator, Aggregate>::deleteMax_(Node * n)
+{
+    if (isRed_(n->left))
+        n = rotateRight_(n);
+
+    if (n->right == nullptr)
+    {
+        nodes_.destroy(n);
+        return nullptr;
+    }
+
+    if (!isRed_(n->right) && !isRed_(n->right->left))
+        n = moveRedRight_(n);
+
+    n->right = deleteMax_(n->right);
+    return balance_(n);
+}
+
+template<typename Key, typename Value, template<typename> class NodeAllocator, typename Aggregate>
+template<typename ForwardIt>
+typename BstRedBlack<Key, Value, NodeAllocator, Aggregate>::Node*
+BstRedBlack<Key, Value, NodeAllocator, Aggregate>::build_(ForwardIt & it, size_t count, unsigned height)
+{
+    if (count == 0)
+        return nullptr;
+
+    const size_t most = maxCount_(height - 1); // max count of items in the subtree
+    const size_t rest = count - 1;
+
+    if (rest <= 2 * most)
+    {
+        // 2-node
+        Node * left = build_(it, rest - rest / 2, height - 1);
+        Node * n = nodes_.create(it->first, it->second, Color::BLACK);
+        ++it;
+        n->left = left;
+        n->right = build_(it, rest / 2, height - 1);
+        update_(n);
+        return n;
+    }
+
+    // 3-node
+    Node * left = build_(it, (rest + 1) / 3, height - 1);
+    Node * red = nodes_.create(it->first, it->second, Color::RED);
+    ++it;
+    red->left = left;
+    red->right = build_(it, rest / 3, height - 1);
+    update_(red);
+
+    Node * n = nodes_.create(it->first, it->second, Color::BLACK);
+    ++it;
+    n->left = red;
+    n->right = build_(it, (rest - 1) / 3, height - 1);
+    update_(n);
     return n;
 }
 
-template<typename Key, typename Value>
-typename BstRedBlack<Key, Value>::Node* BstRedBlack<Key, Value>::deleteNode_(Node * n,  Key k)
+template<typename Key, typename Value, template<typename> class NodeAllocator, typename Aggregate>
+size_t BstRedBlack<Key, Value, NodeAllocator, Aggregate>::maxCount_(unsigned height)
 {
-    // TODO: implement node deleting
-    return nullptr;
+    // 2-3 tree of the given black height holds at most 3^height - 1 items
+    const size_t limit = std::numeric_limits<size_t>::max() / 6;
+    size_t power = 1;
+    for (unsigned i = 0; i < height && power < limit; ++i)
+        power *= 3;
+    return power - 1;
 }
 
-template<typename Key, typename Value>
-typename BstRedBlack<Key, Value>::Node* BstRedBlack<Key, Value>::forgetMin_(BstRedBlack::Node * n)
+template<typename Key, typename Value, template<typename> class NodeAllocator, typename Aggregate>
+typename BstRedBlack<Key, Value, NodeAllocator, Aggregate>::Node* BstRedBlack<Key, Value, NodeAllocator, Aggregate>::forgetMin_(BstRedBlack::Node * n)
 {
     if (n->left == nullptr)
         return n->right;
 
     n->left = forgetMin_(n->left);
-    n->size = bst::size(n->left) + bst::size(n->right) + 1;
+    update_(n);
     return n;
 }
 
 
-template<typename Key, typename Value>
-bool BstRedBlack<Key, Value>::isRed_(const Node * n) const
+template<typename Key, typename Value, template<typename> class NodeAllocator, typename Aggregate>
+bool BstRedBlack<Key, Value, NodeAllocator, Aggregate>::isRed_(const Node * n) const
 {
     return n != nullptr && n->color == Color::RED;
 }
 
-template<typename Key, typename Value>
-typename BstRedBlack<Key, Value>::Node*  BstRedBlack<Key, Value>::rotateLeft_(Node * n)
+template<typename Key, typename Value, template<typename> class NodeAllocator, typename Aggregate>
+typename BstRedBlack<Key, Value, NodeAllocator, Aggregate>::Node*  BstRedBlack<Key, Value, NodeAllocator, Aggregate>::rotateLeft_(Node * n)
 {
     Node * x = n->right;
     n->right = x->left;
     x->left = n;
     x->color = n->color;
     n->color = Color::RED;
-    x->size = n->size;
-    n->size = bst::size(n->left) + bst::size(n->right) + 1;
+    update_(n);
+    update_(x);
     return x;
 }
 
-template<typename Key, typename Value>
-typename BstRedBlack<Key, Value>::Node*  BstRedBlack<Key, Value>::rotateRight_(Node * n)
+template<typename Key, typename Value, template<typename> class NodeAllocator, typename Aggregate>
+typename BstRedBlack<Key, Value, NodeAllocator, Aggregate>::Node*  BstRedBlack<Key, Value, NodeAllocator, Aggregate>::rotateRight_(Node * n)
 {
     Node * x = n->left;
     n->left = x->right;
     x->right = n;
     x->color = n->color;
     n->color = Color::RED;
-    x->size = n->size;
-    n->size = bst::size(n->left) + bst::size(n->right) + 1;
+    update_(n);
+    update_(x);
     return x;
 }
 
-template<typename Key, typename Value>
-void BstRedBlack<Key, Value>::flipColors_(Node * n)
+template<typename Key, typename Value, template<typename> class NodeAllocator, typename Aggregate>
+void BstRedBlack<Key, Value, NodeAllocator, Aggregate>::flipColors_(Node * n)
 {
-    n->color = Color::RED;
+    auto flip = [](Node * x) { x->color = x->color == Color::RED ? Color::BLACK : Color::RED; };
+    flip(n);
     if (n->left != nullptr)
-        n->left->color = Color::BLACK;
+        flip(n->left);
 
     if (n->right != nullptr)
-        n->right->color = Color::BLACK;
+        flip(n->right);
 }
 
-template<typename Key, typename Value>
-bool testRbNodeIsRed(const BstRedBlack<Key, Value> & bst, Key k)
+template<typename Key, typename Value, template<typename> class NodeAllocator, typename Aggregate>
+typename BstRedBlack<Key, Value, NodeAllocator, Aggregate>::Node*  BstRedBlack<Key, Value, NodeAllocator, Aggregate>::moveRedLeft_(Node * n)
+{
+    // borrow a node from the right sibling, or merge with it
+    flipColors_(n);
+    if (isRed_(n->right->left))
+    {
+        n->right = rotateRight_(n->right);
+        n = rotateLeft_(n);
+        flipColors_(n);
+    }
+    return n;
+}
+
+template<typename Key, typename Value, template<typename> class NodeAllocator, typename Aggregate>
+typename BstRedBlack<Key, Value, NodeAllocator, Aggregate>::Node*  BstRedBlack<Key, Value, NodeAllocator, Aggregate>::moveRedRight_(Node * n)
+{
+    // borrow a node from the left sibling, or merge with it
+    flipColors_(n);
+    if (isRed_(n->left->left))
+    {
+        n = rotateRight_(n);
+        flipColors_(n);
+    }
+    return n;
+}
+
+template<typename Key, typename Value, template<typename> class NodeAllocator, typename Aggregate>
+typename BstRedBlack<Key, Value, NodeAllocator, Aggregate>::Node*  BstRedBlack<Key, Value, NodeAllocator, Aggregate>::balance_(Node * n)
+{
+    if (isRed_(n->right) && !isRed_(n->left))
+        n = rotateLeft_(n);
+    if (isRed_(n->left) && isRed_(n->left->left))
+        n = rotateRight_(n);
+    if (isRed_(n->left) && isRed_(n->right))
+        flipColors_(n);
+
+    update_(n);
+    return n;
+}
+
+template<typename Key, typename Value, template<typename> class NodeAllocator, typename Aggregate>
+typename Aggregate::Type BstRedBlack<Key, Value, NodeAllocator, Aggregate>::aggregate(Key lo, Key hi) const
+{
+    static_assert(HasAggregate::value, "BstRedBlack::aggregate: the tree has no aggregate policy");
+    return hi < lo ? Aggregate::identity() : aggregate_(root_, lo, hi, true, true);
+}
+
+template<typename Key, typename Value, template<typename> class NodeAllocator, typename Aggregate>
+void BstRedBlack<Key, Value, NodeAllocator, Aggregate>::updateAggregate_(Node * n, std::true_type)
+{
+    n->agg = Aggregate::of(n->val);
+    if (n->left != nullptr)
+        n->agg = Aggregate::combine(n->left->agg, n->agg);
+    if (n->right != nullptr)
+        n->agg = Aggregate::combine(n->agg, n->right->agg);
+}
+
+template<typename Key, typename Value, template<typename> class NodeAllocator, typename Aggregate>
+typename Aggregate::Type BstRedBlack<Key, Value, NodeAllocator, Aggregate>::aggregate_(
+        const Node * n, const Key & lo, const Key & hi, bool lowBounded, bool highBounded) const
+{
+    // after the paths to lo and hi split, every subtree hanging off them is taken as a whole
+    if (n == nullptr)
+        return Aggregate::identity();
+
+    if (!lowBounded && !highBounded)
+        return n->agg;
+
+    if (lowBounded && n->key < lo)
+        return aggregate_(n->right, lo, hi, lowBounded, highBounded);
+
+    if (highBounded && hi < n->key)
+        return aggregate_(n->left, lo, hi, lowBounded, highBounded);
+
+    return Aggregate::combine(Aggregate::combine(aggregate_(n->left, lo, hi, lowBounded, false),
+                                                 Aggregate::of(n->val)),
+                              aggregate_(n->right, lo, hi, false, highBounded));
+}
+
+template<typename Key, typename Value, template<typename> class NodeAllocator, typename Aggregate>
+bool testRbNodeIsRed(const BstRedBlack<Key, Value, NodeAllocator, Aggregate> & bst, Key k)
 {
     return bst.isRed_(bst::get(bst.root_, k));
 }
 
+/**
+ * @brief Checks that the tree is valid left-leaning red-black tree: keys are ordered, sizes are
+ * correct, red links lean left, no node has two red links and all paths have the same count
+ * of black links.
+ */
+template<typename Key, typename Value, template<typename> class NodeAllocator, typename Aggregate>
+bool testRbIsBalanced(const BstRedBlack<Key, Value, NodeAllocator, Aggregate> & bst)
+{
+    using Node = typename BstRedBlack<Key, Value, NodeAllocator, Aggregate>::Node;
+    size_t blackHeight = 0;
+    bool ok = true;
+    std::function<size_t(const Node *, const Node *, const Node *, size_t)> check =
+        [&](const Node * n, const Node * lo, const Node * hi, size_t blacks) -> size_t
+    {
+        if (n == nullptr)
+        {
+            if (blackHeight == 0)
+                blackHeight = blacks + 1;
+            ok = ok && blackHeight == blacks + 1;
+            return 0;
+        }
+        ok = ok && (lo == nullptr || lo->key < n->key) && (hi == nullptr || n->key < hi->key);
+        ok = ok && !bst.isRed_(n->right) && !(bst.isRed_(n) && bst.isRed_(n->left));
+        size_t size = check(n->left, lo, n, blacks + !bst.isRed_(n)) + check(n->right, n, hi, blacks + !bst.isRed_(n)) + 1;
+        ok = ok && n->size == size;
+        return size;
+    };
+    check(bst.root_, nullptr, nullptr, 0);
+    return ok && !bst.isRed_(bst.root_);
+}
+
 } // namespace bst
 
 //--------------------------------------------------------------------------------------------------
@@ -10,6 +10,9 @@
 
 //--------------------------------------------------------------------------------------------------
 #include "BstHelperFunctions.hpp"
+#include "BstNodeAllocators.hpp"
+
+#include <type_traits>
 //--------------------------------------------------------------------------------------------------
 
 namespace bst // binary search tree
@@ -20,8 +23,9 @@ namespace bst // binary search tree
  * @brief The BinarySearchTree class is the implementation of binary tree structure
  * @tparam Key key type of the tree
  * @tparam Value value type of the tree
+ * @tparam NodeAllocator node allocation policy, NodePool or NodeHeap
  */
-template<typename Key, typename Value>
+template<typename Key, typename Value, template<typename> class NodeAllocator = NodePool>
 class BinarySearchTree
 {
 public:
@@ -38,8 +42,14 @@ public:
     };
 
     /// @brief The BinarySearchTree default constructor..
-    BinarySearchTree() : root_(nullptr) {}
-    ~BinarySearchTree() { bst::clear(root_); }
+    BinarySearchTree() : root_(nullptr), nodes_() {}
+    ~BinarySearchTree() { clear(); }
+
+    BinarySearchTree(const BinarySearchTree &) = delete;
+    BinarySearchTree & operator= (const BinarySearchTree &) = delete;
+
+    /// @brief Deletes all elements of the tree.
+    void clear();
 
     /// @brief Puts new element into the tree.
     void put(Key k, Value v) { root_ = put_(root_, k, v); }
@@ -66,13 +76,13 @@ public:
     Value valueSum() const { return bst::valueSum(root_); }
 
     /// @brief Gets nearest element smaller then given.
-    Key floor(Key k) const { Node * n = bst::floor(root_, k); return n ? n->key : nullptr; }
+    Key floor(Key k) const { Node * n = bst::floor(root_, k); return n ? n->key : Key{}; }
 
     /// @brief Gets nearest element bigger then given.
-    Key ceiling(Key k) const { Node * n = bst::ceiling(root_, k); return n ? n->key : nullptr; }
+    Key ceiling(Key k) const { Node * n = bst::ceiling(root_, k); return n ? n->key : Key{}; }
 
     /// @brief Gets the element by its rank.
-    Key select(size_t r) const { Node * n = bst::select(root_, r); return n ? n->key : nullptr; }
+    Key select(size_t r) const { Node * n = bst::select(root_, r); return n ? n->key : Key{}; }
 
     /// @brief Gets the rank of the element.
     size_t rank(Key k)  const { return bst::rank(root_, k); }
@@ -84,22 +94,44 @@ public:
     std::vector<Key> keys (Key lo, Key hi) const;
 
     /// @brief Returns all keys sorted.
-    std::vector<Key> keys() const { return keys(min(), max()); }
+    std::vector<Key> keys() const { return root_ ? keys(min(), max()) : std::vector<Key>{}; }
+
+    using Iterator = InorderIterator<Node>;
+
+    /// @brief Returns iterator to the node with minimal key.
+    Iterator begin() const { return Iterator::first(root_); }
+
+    /// @brief Returns iterator past the node with maximal key.
+    Iterator end() const { return Iterator(root_); }
+
+    /// @brief Returns lazy range of the nodes within lo-hi interval.
+    InorderRange<Node> range(Key lo, Key hi) const { return bst::range(root_, lo, hi); }
 
 private:
     Node* root_; // Root node of the binary search tree
+    NodeAllocator<Node> nodes_; // Allocator of the tree nodes
 
     Node*  put_(Node * n, Key k, Value v);
     Node*  deleteNode_(Node * n, Key k);
     Node*  forgetMin_(Node * n);
 };
 
-template<typename Key, typename Value>
-typename BinarySearchTree<Key, Value>::Node*
-BinarySearchTree<Key, Value>::put_(BinarySearchTree::Node * n, Key k, Value v)
+template<typename Key, typename Value, template<typename> class NodeAllocator>
+void BinarySearchTree<Key, Value, NodeAllocator>::clear()
+{
+    // pool frees trivially destructible nodes all at once without visiting them
+    if (!NodeAllocator<Node>::RELEASES_ALL || !std::is_trivially_destructible<Node>::value)
+        bst::clear(root_, nodes_);
+    nodes_.release();
+    root_ = nullptr;
+}
+
+template<typename Key, typename Value, template<typename> class NodeAllocator>
+typename BinarySearchTree<Key, Value, NodeAllocator>::Node*
+BinarySearchTree<Key, Value, NodeAllocator>::put_(BinarySearchTree::Node * n, Key k, Value v)
 {
     if(n == nullptr)
-        n = new Node(k, v);
+        n = nodes_.create(k, v);
 
     if (k < n->key)
         n->left = put_(n->left, k, v);
@@ -113,9 +145,9 @@ BinarySearchTree<Key, Value>::put_(BinarySearchTree::Node * n, Key k, Value v)
     return n;
 }
 
-template<typename Key, typename Value>
-typename BinarySearchTree<Key, Value>::Node*
-BinarySearchTree<Key, Value>::deleteNode_(BinarySearchTree::Node * n,  Key k)
+template<typename Key, typename Value, template<typename> class NodeAllocator>
+typename BinarySearchTree<Key, Value, NodeAllocator>::Node*
+BinarySearchTree<Key, Value, NodeAllocator>::deleteNode_(BinarySearchTree::Node * n,  Key k)
 {
     if(n == nullptr)
         return nullptr;
@@ -129,13 +161,13 @@ BinarySearchTree<Key, Value>::deleteNode_(BinarySearchTree::Node * n,  Key k)
         if (n->right == nullptr)
         {
             Node * t = n->left;
-            delete n;
+            nodes_.destroy(n);
             return t;
         }
         if (n->left == nullptr)
         {
             Node * t = n->right;
-            delete n;
+            nodes_.destroy(n);
             return t;
         }
 
@@ -143,16 +175,16 @@ BinarySearchTree<Key, Value>::deleteNode_(BinarySearchTree::Node * n,  Key k)
         n = bst::min(t->right);
         n->right = forgetMin_(t->right);
         n->left = t->left;
-        delete t;
+        nodes_.destroy(t);
     }
 
     n->size = bst::size(n->left) + bst::size(n->right) + 1;
     return n;
 }
 
-template<typename Key, typename Value>
-typename BinarySearchTree<Key, Value>::Node*
-BinarySearchTree<Key, Value>::forgetMin_(BinarySearchTree::Node * n)
+template<typename Key, typename Value, template<typename> class NodeAllocator>
+typename BinarySearchTree<Key, Value, NodeAllocator>::Node*
+BinarySearchTree<Key, Value, NodeAllocator>::forgetMin_(BinarySearchTree::Node * n)
 {
     if (n->left == nullptr)
         return n->right;
@@ -162,8 +194,8 @@ BinarySearchTree<Key, Value>::forgetMin_(BinarySearchTree::Node * n)
     return n;
 }
 
-template<typename Key, typename Value>
-std::vector<Key> BinarySearchTree<Key, Value>::keys(Key lo, Key hi) const
+template<typename Key, typename Value, template<typename> class NodeAllocator>
+std::vector<Key> BinarySearchTree<Key, Value, NodeAllocator>::keys(Key lo, Key hi) const
 {
     std::vector<Key> vec;
     bst::keys(root_, vec, lo, hi);
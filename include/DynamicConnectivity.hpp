@@ -0,0 +1,121 @@
+/**
+ * @author Volodymyr Lotoshko (vlotoshko@gmail.com)
+ * @date 19-Oct-2026
+ */
+
+// -------------------------------------------------------------------------------------------------
+#ifndef DYNAMIC_CONNECTIVITY_HPP
+#define DYNAMIC_CONNECTIVITY_HPP
+// -------------------------------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------------
+#include "UnionFind.hpp"
+
+#include <map>
+#include <utility>
+#include <vector>
+// -------------------------------------------------------------------------------------------------
+
+namespace graph
+{
+
+/**
+ * @class OfflineDynamicConnectivity
+ * @brief The OfflineDynamicConnectivity class answers whether two vertexes of the non-directed
+ * graph were connected at the given moment of the history of edge additions and removals.
+ *
+ * Time is the count of the events applied so far: time 0 is the empty graph, time t is the
+ * graph after the first t events. All events and queries are collected first, then solve
+ * answers all queries at once in O((e + q) * log(e) * log(v)): every edge is put into
+ * the segment tree over time on the nodes covering its life interval, and the tree is
+ * traversed with the UnionFind_Rollback structure, undoing unions on the way back.
+ */
+class OfflineDynamicConnectivity
+{
+public:
+    /**
+     * @brief The OfflineDynamicConnectivity constructor creates empty history.
+     * @param[in] v count of the vertexes
+     */
+    explicit OfflineDynamicConnectivity(size_t v);
+
+    /**
+     * @brief Adds the edge to the graph. Parallel edges are counted separately.
+     * @param[in] v vertex 'from'
+     * @param[in] w vertex 'to'
+     * @return time right after the event.
+     */
+    size_t addEdge(size_t v, size_t w);
+
+    /**
+     * @brief Removes the edge from the graph.
+     * @param[in] v vertex 'from'
+     * @param[in] w vertex 'to'
+     * @return time right after the event.
+     * @throws std::invalid_argument if there is no such edge in the graph.
+     */
+    size_t removeEdge(size_t v, size_t w);
+
+    /// @return current time, i.e. count of the events.
+    size_t time() const { return time_; }
+
+    /**
+     * @brief Registers the question whether vertexes are connected at the given time.
+     * @param[in] v vertex 'from'
+     * @param[in] w vertex 'to'
+     * @param[in] t time, must not exceed the time of the last event when solve is called
+     * @return index of the answer in the container returned by solve.
+     */
+    size_t query(size_t v, size_t w, size_t t);
+
+    /**
+     * @brief Answers all registered queries.
+     * @return answers in the order queries were registered.
+     * @throws std::out_of_range if some query is made after the last event.
+     */
+    std::vector<bool> solve() const;
+
+private:
+    /// @brief edge with its life interval [from, to] in time
+    struct Interval
+    {
+        size_t from;
+        size_t to;
+        size_t v;
+        size_t w;
+    };
+
+    /// @brief registered question
+    struct Query
+    {
+        size_t v;
+        size_t w;
+        size_t t;
+    };
+
+    /// segment tree over time, nodes hold edges alive on the whole node's range
+    using SegmentTree = std::vector<std::vector<std::pair<size_t, size_t>>>;
+
+    void insert(SegmentTree & tree, size_t node, size_t lo, size_t hi, const Interval & edge) const;
+
+    void traverse(const SegmentTree & tree, size_t node, size_t lo, size_t hi,
+                  const std::vector<std::vector<size_t>> & queriesAt,
+                  uf::UnionFindRollbackInfo<size_t> & ufData, std::vector<bool> & answers) const;
+
+    /// count of the vertexes
+    size_t v_;
+    /// count of the events
+    size_t time_;
+    /// times when currently alive edges were added, parallel edges are stacked
+    std::map<std::pair<size_t, size_t>, std::vector<size_t>> alive_;
+    /// edges which were already removed
+    std::vector<Interval> closed_;
+    /// registered queries
+    std::vector<Query> queries_;
+};
+
+} // namespace graph
+
+//--------------------------------------------------------------------------------------------------
+#endif // DYNAMIC_CONNECTIVITY_HPP
+//--------------------------------------------------------------------------------------------------
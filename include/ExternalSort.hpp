@@ -0,0 +1,462 @@
+/**
+ * @author Volodymyr Lotoshko (vlotoshko@gmail.com)
+ * @date 19-Oct-2026
+ */
+
+//--------------------------------------------------------------------------------------------------
+#ifndef EXTERNAL_SORT_HPP
+#define EXTERNAL_SORT_HPP
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+#include "Sort_Impl.hpp"
+#include "TaskPool.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+//--------------------------------------------------------------------------------------------------
+
+namespace sort
+{
+
+/**
+ * @class ExternalSort
+ * @brief The ExternalSort template class sorts the file of fixed-size records which does not fit
+ * into the memory. Complexity: O(n*log(n)) comparisons, O(n*passes) of sequential I/O.
+ * @tparam T type of the record, must be trivially copyable
+ * @tparam Sorter sort algorithm of the runs, e.g. PdqSort or PowerSort for the stable sort
+ * @tparam Compare comparator of the keys
+ * @tparam Projection function object which maps the record to its key
+ *
+ * 1. Runs: the input is read by chunks which fill a half of the memory budget, every chunk is
+ * sorted in memory and written to the temporary file. With the task pool several chunks are read
+ * at once and sorted in parallel, they share the same budget.
+ * 2. Merge: up to fan-in runs are merged at once by the loser tree, every run and the output
+ * get equal parts of the budget as I/O buffers. Fan-in is limited so buffers are not smaller than
+ * MIN_BUFFER bytes and open run files do not exhaust the file descriptors. Runs are merged by
+ * levels while they are made: when fan-in runs of one level are collected, they are merged into
+ * one run of the next level, so count of open runs stays small for any size of the input. In
+ * the end all the rest runs are merged, by groups in several passes if needed.
+ * Groups are made of adjacent runs and the loser tree prefers the earlier run on ties, so the
+ * sort is stable if Sorter is stable.
+ */
+template <typename T, template <typename...> class Sorter = PdqSort, typename Compare = std::less<>, typename Projection = Identity>
+class ExternalSort
+{
+    static_assert(std::is_trivially_copyable<T>::value, "ExternalSort requires trivially copyable records");
+
+public:
+    /**
+     * @brief The ExternalSort constructor.
+     * @param[in] memoryBudget bytes of memory used for records, scratch buffers of the sorter and
+     * I/O buffers. While runs are made, records take a half of the budget and the other half is
+     * left for the sorter; while runs are merged, the budget is shared by the I/O buffers. These
+     * phases do not overlap
+     * @param[in] pool task pool which sorts the runs in parallel, nullptr to sort them in the
+     * calling thread
+     * @param[in] maxOpenRuns max count of run files open at once, 0 to take a half of the
+     * process limit of open files (DEFAULT_OPEN_RUNS if the limit is unknown)
+     * @param[in] tempDirectory directory of the run files, they take as much space as the input,
+     * empty to use TMPDIR or /tmp. Runs are deleted from the directory right after creation, so
+     * they do not remain there even if the process crashes
+     */
+    explicit ExternalSort(size_t memoryBudget = DEFAULT_BUDGET, tools::TaskPool * pool = nullptr, size_t maxOpenRuns = 0,
+                          const std::string & tempDirectory = std::string())
+        : budget_(memoryBudget), pool_(pool), maxOpenRuns_(maxOpenRuns), tempDirectory_(tempDirectory)
+    {}
+
+    /**
+     * @brief Sorts records of the input file and writes them to the output file.
+     * @param[in] input name of the file with records
+     * @param[in] output name of the file for the sorted records, it may be the input file
+     * @throws std::runtime_error if files can not be read or written or the size of the input is
+     * not multiple of the record size
+     */
+    void sort(const std::string & input, const std::string & output);
+
+    /// @brief Returns count of runs made by the last sort.
+    size_t runs() const { return runs_; }
+
+    /// @brief Returns max count of merges which one record went through in the last sort.
+    size_t passes() const { return passes_; }
+
+private:
+    enum : size_t
+    {
+        DEFAULT_BUDGET = size_t(64) << 20,
+        MIN_BUFFER = 4096,                  // min bytes of I/O buffer of one run while merging
+        DEFAULT_OPEN_RUNS = 256,            // max open runs if the limit of open files is unknown
+        MAX_LEVELS = 8                      // levels of runs which fit into the limit of open runs
+    };
+
+    using File = std::unique_ptr<std::FILE, int (*)(std::FILE *)>;
+
+    /// @brief Buffered reader of the run file
+    struct Reader
+    {
+        std::FILE * file;
+        std::vector<T> buffer;
+        size_t pos;
+        size_t count;
+
+        bool exhausted() const { return pos == count; }
+        const T & current() const { return buffer[pos]; }
+        void next() { if (++pos == count) fill(); }
+        void fill();
+    };
+
+    /**
+     * @brief The LoserTree class selects the least current record of the readers. Every inner
+     * node keeps the reader which lost the match in the node, so replacing the winner replays
+     * only the matches on its path to the root: log(k) comparisons per record.
+     */
+    class LoserTree
+    {
+    public:
+        explicit LoserTree(std::vector<Reader> & readers)
+            : readers_(readers), losers_(readers.size()), winner_(build_(1))
+        {}
+
+        /// @brief Reader with the least record
+        Reader & winner() { return readers_[winner_]; }
+
+        /// @brief Restores the tree after the record of the winner was taken.
+        void replay();
+
+    private:
+        std::vector<Reader> & readers_;
+        std::vector<size_t> losers_;    // losers of the inner nodes 1..k-1, leaf i is node k+i
+        size_t winner_;
+
+        bool beats_(size_t a, size_t b) const;
+        size_t build_(size_t node);
+    };
+
+    size_t budget_;
+    tools::TaskPool * pool_;
+    size_t maxOpenRuns_;
+    std::string tempDirectory_;
+    size_t runs_ = 0;
+    size_t passes_ = 0;
+
+    static File open_(const std::string & name, const char * mode);
+    File temporary_() const;
+    static void write_(std::FILE * file, const T * records, size_t count);
+
+    /// @brief Returns count of runs merged at once.
+    size_t fanIn_() const;
+
+    /**
+     * @brief Reads the input by chunks, sorts them and writes them to temporary files.
+     * @param[in] input the input file
+     * @param[in, out] levels runs of every level, run of the level i was merged i times
+     * @param[in] fanIn count of runs of one level which are merged into the run of the next one
+     * @return count of the made runs
+     */
+    size_t makeRuns_(std::FILE * input, std::vector<std::vector<File>> & levels, size_t fanIn) const;
+
+    /// @brief Adds the run to the level and merges the full levels.
+    void addRun_(std::vector<std::vector<File>> & levels, File run, size_t fanIn) const;
+
+    /// @brief Merges the runs into the output file.
+    void merge_(File * first, File * last, std::FILE * output) const;
+};
+
+// ----- ExternalSort -----
+
+template <typename T, template <typename...> class Sorter, typename Compare, typename Projection>
+void ExternalSort<T, Sorter, Compare, Projection>::sort(const std::string & input, const std::string & output)
+{
+    const size_t fanIn = fanIn_();
+    std::vector<std::vector<File>> levels;
+    {
+        File file = open_(input, "rb");
+        runs_ = makeRuns_(file.get(), levels, fanIn);
+    }
+
+    // runs of the upper levels are made of the earlier records
+    std::vector<File> runs;
+    for (size_t level = levels.size(); level-- > 0; )
+    {
+        for (auto & run : levels[level])
+            runs.push_back(std::move(run));
+    }
+    passes_ = levels.size() - 1;
+
+    while (runs.size() > fanIn)
+    {
+        std::vector<File> merged;
+        for (size_t i = 0; i < runs.size(); i += fanIn)
+        {
+            merged.push_back(temporary_());
+            merge_(runs.data() + i, runs.data() + std::min(runs.size(), i + fanIn), merged.back().get());
+        }
+        runs = std::move(merged);
+        ++passes_;
+    }
+
+    File file = open_(output, "wb");
+    merge_(runs.data(), runs.data() + runs.size(), file.get());
+    ++passes_;
+    if (std::fclose(file.release()) != 0)
+        throw std::runtime_error("ExternalSort: can not write " + output);
+}
+
+template <typename T, template <typename...> class Sorter, typename Compare, typename Projection>
+size_t ExternalSort<T, Sorter, Compare, Projection>::fanIn_() const
+{
+    size_t openRuns = maxOpenRuns_;
+    if (openRuns == 0)
+    {
+        openRuns = DEFAULT_OPEN_RUNS;
+#ifndef _WIN32
+        const long openFiles = sysconf(_SC_OPEN_MAX);
+        if (openFiles > 0)
+            openRuns = static_cast<size_t>(openFiles) / 2;
+#endif
+    }
+
+    // every level keeps up to fan-in - 1 runs open, so the limit is shared by MAX_LEVELS levels
+    return std::max<size_t>(2, std::min(openRuns / MAX_LEVELS, budget_ / MIN_BUFFER - 1));
+}
+
+template <typename T, template <typename...> class Sorter, typename Compare, typename Projection>
+size_t ExternalSort<T, Sorter, Compare, Projection>::makeRuns_(std::FILE * input, std::vector<std::vector<File>> & levels, size_t fanIn) const
+{
+    // a half of the budget is left for the scratch buffers of the stable sorters
+    const size_t chunks = pool_ != nullptr ? pool_->threads() + 1 : 1;
+    const size_t chunkLength = std::max<size_t>(1, budget_ / 2 / sizeof(T) / chunks);
+
+    size_t runs = 0;
+    std::vector<std::vector<T>> batch(chunks);
+    bool eof = false;
+    while (!eof)
+    {
+        // 1. read chunks
+        size_t count = 0;
+        for (; count < chunks && !eof; ++count)
+        {
+            auto & chunk = batch[count];
+            chunk.resize(chunkLength);
+            size_t bytes = std::fread(chunk.data(), 1, chunkLength * sizeof(T), input);
+            if (std::ferror(input))
+                throw std::runtime_error("ExternalSort: can not read the input");
+            if (bytes % sizeof(T) != 0)
+                throw std::runtime_error("ExternalSort: size of the input is not multiple of the record size");
+
+            chunk.resize(bytes / sizeof(T));
+            eof = bytes < chunkLength * sizeof(T);
+            if (chunk.empty())
+                break;
+        }
+
+        // 2. sort chunks
+        if (count > 1)
+        {
+            std::vector<std::function<void()>> tasks;
+            for (size_t i = 0; i < count; ++i)
+                tasks.push_back([&batch, i]() { Sorter<T, Compare, Projection>::sort(batch[i]); });
+            pool_->run(tasks);
+        }
+        else if (count == 1)
+        {
+            Sorter<T, Compare, Projection>::sort(batch[0]);
+        }
+
+        // 3. write runs
+        std::vector<File> written;
+        for (size_t i = 0; i < count; ++i)
+        {
+            written.push_back(temporary_());
+            write_(written.back().get(), batch[i].data(), batch[i].size());
+        }
+
+        // 4. merge full levels, buffers of merging take the whole budget, so chunks are freed
+        for (auto & chunk : batch)
+            std::vector<T>().swap(chunk);
+        for (auto & run : written)
+        {
+            addRun_(levels, std::move(run), fanIn);
+            ++runs;
+        }
+    }
+
+    if (runs == 0)
+    {
+        addRun_(levels, temporary_(), fanIn);
+        ++runs;
+    }
+    return runs;
+}
+
+template <typename T, template <typename...> class Sorter, typename Compare, typename Projection>
+void ExternalSort<T, Sorter, Compare, Projection>::addRun_(std::vector<std::vector<File>> & levels, File run, size_t fanIn) const
+{
+    for (size_t level = 0; ; ++level)
+    {
+        if (level == levels.size())
+            levels.emplace_back();
+        levels[level].push_back(std::move(run));
+        if (levels[level].size() < fanIn)
+            return;
+
+        run = temporary_();
+        merge_(levels[level].data(), levels[level].data() + fanIn, run.get());
+        levels[level].clear();
+    }
+}
+
+template <typename T, template <typename...> class Sorter, typename Compare, typename Projection>
+void ExternalSort<T, Sorter, Compare, Projection>::merge_(File * first, File * last, std::FILE * output) const
+{
+    const size_t k = static_cast<size_t>(last - first);
+    const size_t bufferLength = std::max<size_t>(1, budget_ / sizeof(T) / (k + 1));
+
+    std::vector<Reader> readers;
+    for (File * run = first; run != last; ++run)
+    {
+        // the run was written, the buffered tail must reach the file before it is read back
+        if (std::fflush(run->get()) != 0 || std::fseek(run->get(), 0, SEEK_SET) != 0)
+            throw std::runtime_error("ExternalSort: can not write the run");
+        readers.push_back(Reader{run->get(), std::vector<T>(bufferLength), 0, 0});
+        readers.back().fill();
+    }
+
+    std::vector<T> out;
+    out.reserve(bufferLength);
+    LoserTree tree(readers);
+    while (!tree.winner().exhausted())
+    {
+        out.push_back(tree.winner().current());
+        if (out.size() == bufferLength)
+        {
+            write_(output, out.data(), out.size());
+            out.clear();
+        }
+        tree.winner().next();
+        tree.replay();
+    }
+    write_(output, out.data(), out.size());
+
+    // merged runs are not needed anymore, closing deletes them
+    for (File * run = first; run != last; ++run)
+        run->reset();
+}
+
+template <typename T, template <typename...> class Sorter, typename Compare, typename Projection>
+typename ExternalSort<T, Sorter, Compare, Projection>::File ExternalSort<T, Sorter, Compare, Projection>::open_(const std::string & name, const char * mode)
+{
+    File file(std::fopen(name.c_str(), mode), &std::fclose);
+    if (!file)
+        throw std::runtime_error("ExternalSort: can not open " + name);
+    return file;
+}
+
+template <typename T, template <typename...> class Sorter, typename Compare, typename Projection>
+typename ExternalSort<T, Sorter, Compare, Projection>::File ExternalSort<T, Sorter, Compare, Projection>::temporary_() const
+{
+    // std::tmpfile ignores TMPDIR and creates files in /tmp, which is often small or in memory
+    std::string directory = tempDirectory_;
+#ifndef _WIN32
+    if (directory.empty())
+    {
+        const char * tmp = std::getenv("TMPDIR");
+        directory = tmp != nullptr && *tmp != '\0' ? tmp : "/tmp";
+    }
+    std::string name = directory + "/external_sort_XXXXXX";
+    const int fd = mkstemp(&name[0]);
+    File file(fd >= 0 ? fdopen(fd, "w+b") : nullptr, &std::fclose);
+    if (fd >= 0)
+    {
+        // the file is deleted when it is closed
+        unlink(name.c_str());
+        if (!file)
+            close(fd);
+    }
+#else
+    char * name = _tempnam(directory.empty() ? nullptr : directory.c_str(), "sort");
+    // T - keep in the cache if possible, D - delete on closing
+    File file(name != nullptr ? std::fopen(name, "w+bTD") : nullptr, &std::fclose);
+    std::free(name);
+#endif
+    if (!file)
+        throw std::runtime_error("ExternalSort: can not create temporary file in " + directory);
+    return file;
+}
+
+template <typename T, template <typename...> class Sorter, typename Compare, typename Projection>
+void ExternalSort<T, Sorter, Compare, Projection>::write_(std::FILE * file, const T * records, size_t count)
+{
+    if (count > 0 && std::fwrite(records, sizeof(T), count, file) != count)
+        throw std::runtime_error("ExternalSort: can not write records");
+}
+
+template <typename T, template <typename...> class Sorter, typename Compare, typename Projection>
+void ExternalSort<T, Sorter, Compare, Projection>::Reader::fill()
+{
+    count = std::fread(buffer.data(), sizeof(T), buffer.size(), file);
+    pos = 0;
+    if (std::ferror(file))
+        throw std::runtime_error("ExternalSort: can not read the run");
+}
+
+template <typename T, template <typename...> class Sorter, typename Compare, typename Projection>
+void ExternalSort<T, Sorter, Compare, Projection>::LoserTree::replay()
+{
+    const size_t k = readers_.size();
+    size_t winner = winner_;
+    for (size_t node = (winner + k) / 2; node >= 1; node /= 2)
+    {
+        if (beats_(losers_[node], winner))
+            std::swap(losers_[node], winner);
+    }
+    winner_ = winner;
+}
+
+template <typename T, template <typename...> class Sorter, typename Compare, typename Projection>
+bool ExternalSort<T, Sorter, Compare, Projection>::LoserTree::beats_(size_t a, size_t b) const
+{
+    // exhausted reader loses to everyone, the earlier reader wins on ties
+    const Reader & ra = readers_[a];
+    const Reader & rb = readers_[b];
+    if (ra.exhausted() || rb.exhausted())
+        return !ra.exhausted();
+    if (less<T, Compare, Projection>(ra.current(), rb.current()))
+        return true;
+    return !less<T, Compare, Projection>(rb.current(), ra.current()) && a < b;
+}
+
+template <typename T, template <typename...> class Sorter, typename Compare, typename Projection>
+size_t ExternalSort<T, Sorter, Compare, Projection>::LoserTree::build_(size_t node)
+{
+    const size_t k = readers_.size();
+    if (node >= k)
+        return node - k;
+
+    size_t a = build_(2 * node);
+    size_t b = build_(2 * node + 1);
+    if (beats_(a, b))
+    {
+        losers_[node] = b;
+        return a;
+    }
+    losers_[node] = a;
+    return b;
+}
+
+} // namespace sort
+
+//--------------------------------------------------------------------------------------------------
+#endif // EXTERNAL_SORT_HPP
+//--------------------------------------------------------------------------------------------------
@@ -10,6 +10,7 @@
 
 // -------------------------------------------------------------------------------------------------
 #include "Graph.hpp"
+#include "UnionFindConcurrent.hpp"
 
 #include <string>
 #include <vector>
@@ -20,6 +21,7 @@
 #include <memory>
 #include <sstream>
 #include <functional>
+#include <thread>
 // -------------------------------------------------------------------------------------------------
 
 namespace graph
@@ -541,6 +543,53 @@ private:
 };
 
 
+/**
+ * @class ParallelCoupledComponents
+ * @brief The ParallelCoupledComponents template class searches for coupled components in the
+ * given non-directed graph using concurrent union-find, vertexes are split between threads.
+ * @tparam G graph type
+ *
+ * Ids of the components are the same as CoupledComponents gives: components are numbered in
+ * order of their smallest vertex.
+ */
+template<typename G>
+class ParallelCoupledComponents
+{
+public:
+    /**
+     * @brief The ParallelCoupledComponents constructor searches for coupled components
+     * @param[in] g non-directed graph
+     * @param[in] threads count of the threads to use, 0 means hardware concurrency
+     */
+    explicit ParallelCoupledComponents(const G & g, size_t threads = 0);
+
+    /**
+     * @brief Checks whether two vertexes are connected.
+     * @param[in] v vertex 'from'
+     * @param[in] w vertex 'to'
+     * @return true if components are connected.
+     */
+    bool connected(const size_t & v, const size_t & w) const { return id_[v] == id_[w]; }
+
+    /// @return the count of coupled components in the given graph.
+    size_t componentsCount() const { return count_; }
+
+    /**
+     * @brief Returns id of the component to which belongs the given vertex.
+     * @param[in] v initial vertex
+     * @return id of the component to which belongs the given vertex.
+     */
+    size_t id(const size_t & v) const { return id_[v]; }
+
+private:
+    /// the count of coupled components in the given graph
+    size_t count_;
+
+    /// holds ids of coupled components for every vertex
+    std::vector<size_t> id_;
+};
+
+
 /**
  * @class TwoColored
  * @brief The TwoColored class defines whether graph is bipartite or not, using
@@ -875,6 +924,62 @@ void KosarajuSCC<G>::dfs(const G & g, const size_t & v)
     }
 }
 
+
+// -------------------------------------------------------------------------------
+// ----- ParallelCoupledComponents -----
+//
+
+template <typename G>
+ParallelCoupledComponents<G>::ParallelCoupledComponents(const G & g, size_t threads)
+    : count_(0), id_(g.vertexCount())
+{
+    const size_t vertexes = g.vertexCount();
+    if (threads == 0)
+    {
+        threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    threads = std::max<size_t>(std::min(threads, vertexes), 1);
+
+    uf::UnionFindConcurrentInfo<size_t> ufData(vertexes);
+
+    auto unite = [&g, &ufData](size_t from, size_t to) {
+        uf::UnionFind_Concurrent<size_t> unionFind;
+        for (size_t v = from; v < to; ++v)
+        {
+            for (auto const & edge : g[v])
+            {
+                unionFind.unionComponents(ufData, v, edge.other(v));
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    const size_t chunk = (vertexes + threads - 1) / threads;
+    for (size_t from = chunk; from < vertexes; from += chunk)
+    {
+        workers.emplace_back(unite, from, std::min(from + chunk, vertexes));
+    }
+    unite(0, std::min(chunk, vertexes));
+
+    for (auto & worker : workers)
+    {
+        worker.join();
+    }
+
+    const size_t none = vertexes;
+    std::vector<size_t> rootIds(vertexes, none);
+    uf::UnionFind_Concurrent<size_t> unionFind;
+    for (size_t v = 0; v < vertexes; ++v)
+    {
+        auto & rootId = rootIds[unionFind.find(ufData, v)];
+        if (rootId == none)
+        {
+            rootId = count_++;
+        }
+        id_[v] = rootId;
+    }
+}
+
 } // namespace graph
 
 //--------------------------------------------------------------------------------------------------
@@ -0,0 +1,145 @@
+/**
+ * @author Volodymyr Lotoshko (vlotoshko@gmail.com)
+ * @date 19-Oct-2026
+ */
+
+//--------------------------------------------------------------------------------------------------
+#ifndef HASH_FUNCTIONS_HPP
+#define HASH_FUNCTIONS_HPP
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <type_traits>
+//--------------------------------------------------------------------------------------------------
+
+namespace hash
+{
+
+/**
+ * @brief Mixes bits of the 64-bit word, so every input bit affects every output bit
+ * (the splitmix64 finalizer).
+ * @param[in] x word to mix
+ * @return mixed word.
+ */
+inline uint64_t mix64(uint64_t x)
+{
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBull;
+    x ^= x >> 31;
+    return x;
+}
+
+/**
+ * @brief Hashes the bytes of the buffer 8 bytes per round in the xxHash64 manner.
+ * @param[in] data buffer
+ * @param[in] length length of the buffer in bytes
+ * @param[in] seed seed of the hash
+ * @return hash of the buffer.
+ */
+inline uint64_t hashBytes(const void * data, size_t length, uint64_t seed = 0)
+{
+    const uint64_t prime1 = 0x9E3779B185EBCA87ull;
+    const uint64_t prime2 = 0xC2B2AE3D27D4EB4Full;
+    auto bytes = static_cast<const unsigned char *>(data);
+
+    uint64_t h = seed ^ (length * prime1);
+    for (; length >= 8; length -= 8, bytes += 8)
+    {
+        uint64_t word;
+        std::memcpy(&word, bytes, 8);
+        h ^= word * prime2;
+        h = ((h << 31) | (h >> 33)) * prime1;
+    }
+
+    uint64_t tail = 0;
+    std::memcpy(&tail, bytes, length);
+    h ^= tail * prime2;
+    return mix64(h);
+}
+
+/**
+ * @brief Maps the hash to the index of power of two sized table using its high bits after
+ * multiplication by 2^64 / golden ratio (Fibonacci hashing).
+ * @param[in] h hash
+ * @param[in] shift 64 - log2 of the table size
+ * @return index in the table.
+ */
+inline size_t fibonacciIndex(uint64_t h, unsigned shift)
+{
+    return shift < 64 ? static_cast<size_t>((h * 0x9E3779B97F4A7C15ull) >> shift) : 0;
+}
+
+/**
+ * @brief Returns shift for fibonacciIndex for the given power of two table size.
+ * @param[in] size size of the table, must be power of two
+ * @return 64 - log2(size).
+ */
+inline unsigned fibonacciShift(size_t size)
+{
+    unsigned shift = 64;
+    for (; size > 1; size /= 2)
+    {
+        --shift;
+    }
+    return shift;
+}
+
+/**
+ * @brief Rounds the size up to power of two.
+ * @param[in] size size
+ * @return the smallest power of two not less than size.
+ */
+inline size_t powerOfTwo(size_t size)
+{
+    size_t result = 1;
+    while (result < size)
+    {
+        result *= 2;
+    }
+    return result;
+}
+
+/**
+ * @struct Hasher
+ * @brief The Hasher template struct is the default hash function of the hash tables. It mixes
+ * std::hash result, because for integers the standard one is usually the identity.
+ * @tparam Key key type
+ */
+template<typename Key, typename = void>
+struct Hasher
+{
+    size_t operator()(const Key & k) const { return static_cast<size_t>(mix64(std::hash<Key>{}(k))); }
+};
+
+/**
+ * @struct Hasher
+ * @brief The Hasher specialization for integral keys mixes bits of the key, so sequential ids
+ * are spread over the whole table.
+ */
+template<typename Key>
+struct Hasher<Key, typename std::enable_if<std::is_integral<Key>::value>::type>
+{
+    size_t operator()(const Key & k) const { return static_cast<size_t>(mix64(static_cast<uint64_t>(k))); }
+};
+
+/**
+ * @struct Hasher
+ * @brief The Hasher specialization for strings hashes their bytes with hashBytes.
+ */
+template<>
+struct Hasher<std::string>
+{
+    size_t operator()(const std::string & k) const { return static_cast<size_t>(hashBytes(k.data(), k.size())); }
+};
+
+} // namespace hash
+
+//--------------------------------------------------------------------------------------------------
+#endif // HASH_FUNCTIONS_HPP
+//--------------------------------------------------------------------------------------------------
@@ -9,7 +9,10 @@
 //--------------------------------------------------------------------------------------------------
 
 //--------------------------------------------------------------------------------------------------
+#include "HashFunctions.hpp"
+
 #include <algorithm>
+#include <iterator>
 #include <list>
 #include <vector>
 //--------------------------------------------------------------------------------------------------
@@ -17,20 +20,60 @@
 namespace hash
 {
 
+/**
+ * @struct HashTableStats
+ * @brief The HashTableStats struct holds information about items distribution in the hash table.
+ */
+struct HashTableStats
+{
+    /// count of items
+    size_t items;
+    /// count of buckets, including previous buckets while rehashing
+    size_t buckets;
+    /// count of non-empty buckets
+    size_t usedBuckets;
+    /// ratio between count of items and count of buckets
+    double loadFactor;
+    /// length of the longest chain
+    size_t maxChain;
+    /// average length of non-empty chains
+    double avgChain;
+    /// average count of key comparisons to find an existing item
+    double avgProbes;
+    /// approximate count of bytes used by the table
+    size_t bytes;
+};
+
 /**
  * @class HashTableChaining
  * @brief The HashTableChaining class is the hash table with the chaining method collision resolve
  * @tparam Key key type of the table
  * @tparam Value value type of the table
+ * @tparam HashFunction functor which maps key to size_t
+ *
+ * Count of buckets is rounded up to power of two, hash is mapped to the bucket by Fibonacci
+ * hashing, so all bits of the hash take part in choosing the bucket.
+ *
+ * The table doubles when there are more items than buckets and halves when items occupy less
+ * than 1/8 of buckets, but never gets smaller than the initial size. Rehashing is incremental:
+ * the previous buckets are kept aside and every put/del moves REHASH_STEP of them into the new
+ * buckets, so no single operation rebuilds the whole table. A key lives in the previous buckets
+ * until its bucket is moved.
  */
-template<typename Key, typename Value>
+template<typename Key, typename Value, typename HashFunction = Hasher<Key>>
 class HashTableChaining
 {
 public:
-    using HashTable = std::vector<std::list<std::pair<Key, Value>>>;
+    using Chain = std::list<std::pair<Key, Value>>;
+    using HashTable = std::vector<Chain>;
+
+    /// @brief count of the previous buckets moved by every put/del while rehashing
+    static const size_t REHASH_STEP = 4;
 
     /// @brief The HashTableChaining constructor/destructor.
-    explicit HashTableChaining(size_t size) : hashTable_(size) {}
+    explicit HashTableChaining(size_t size)
+        : hashTable_(powerOfTwo(size)), shift_(fibonacciShift(hashTable_.size())), oldTable_(), oldShift_(0)
+        , migrated_(0), size_(0), minBuckets_(hashTable_.size()), hasher_() {}
     ~HashTableChaining() {}
 
     /// @brief Puts new value into the table.
@@ -42,12 +85,155 @@ public:
     /// @brief Deletes item with the given key.
     void del(Key k);
 
+    /// @brief Returns count of items in the table.
+    size_t size() const { return size_; }
+
+    /// @brief Returns count of the buckets items are being moved to.
+    size_t bucketsCount() const { return hashTable_.size(); }
+
+    /// @brief Returns ratio between count of items and count of buckets.
+    double loadFactor() const { return static_cast<double>(size_) / bucketsCount(); }
+
+    /// @brief Defines whether items are being moved from the previous buckets.
+    bool rehashing() const { return !oldTable_.empty(); }
+
+    /**
+     * @brief Puts many items into the table. Buckets are allocated once for the whole batch,
+     * so no rehashing happens while inserting.
+     * @tparam ForwardIt forward iterator of the pairs key-value
+     * @param[in] first beginning of the items
+     * @param[in] last end of the items
+     */
+    template<typename ForwardIt>
+    void putAll(ForwardIt first, ForwardIt last);
+
+    /// @brief Rebuilds the table at once to hold the given count of items without growth.
+    void reserve(size_t count);
+
+    /// @brief Calculates statistics of the items distribution.
+    HashTableStats stats() const;
+
+    class ConstIterator;
+
+    /// @brief Returns iterator to the first item, items are not ordered.
+    ConstIterator begin() const { return ConstIterator(this, 0); }
+
+    /// @brief Returns iterator past the last item.
+    ConstIterator end() const { return ConstIterator(this, oldTable_.size() + hashTable_.size()); }
+
+    /**
+     * @class ConstIterator
+     * @brief The ConstIterator class is the forward iterator over items of the table. Goes through
+     * previous buckets first while rehashing. Invalidated by put and del.
+     */
+    class ConstIterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::pair<Key, Value>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type *;
+        using reference = const value_type &;
+
+        ConstIterator() : table_(nullptr), bucket_(0), item_() {}
+
+        reference operator*() const { return *item_; }
+        pointer operator->() const { return &*item_; }
+
+        ConstIterator & operator++()
+        {
+            if (++item_ == table_->bucket(bucket_).end())
+            {
+                ++bucket_;
+                skipEmpty();
+            }
+            return *this;
+        }
+
+        ConstIterator operator++(int) { ConstIterator it = *this; ++*this; return it; }
+
+        bool operator==(const ConstIterator & other) const
+        {
+            // default constructed iterators have no table, end iterators have no item
+            return table_ == other.table_ && bucket_ == other.bucket_
+                && (table_ == nullptr || bucket_ == table_->bucketsTotal() || item_ == other.item_);
+        }
+        bool operator!=(const ConstIterator & other) const { return !(*this == other); }
+
+    private:
+        friend class HashTableChaining;
+
+        ConstIterator(const HashTableChaining * table, size_t bucket) : table_(table), bucket_(bucket), item_()
+        {
+            skipEmpty();
+        }
+
+        void skipEmpty()
+        {
+            while (bucket_ < table_->bucketsTotal() && table_->bucket(bucket_).empty())
+            {
+                ++bucket_;
+            }
+            if (bucket_ < table_->bucketsTotal())
+            {
+                item_ = table_->bucket(bucket_).begin();
+            }
+        }
+
+        const HashTableChaining * table_;
+        size_t bucket_;
+        typename Chain::const_iterator item_;
+    };
+
 private:
     /// @brief hashTable_ container that contains items
     HashTable hashTable_;
 
-    /// @brief Simple modular hash-fucntion
-    size_t hash(Key k) const { return k % hashTable_.size(); }
+    /// @brief Shift which leaves log2(buckets count) high bits of the 64-bit hash
+    unsigned shift_;
+
+    /// @brief Previous buckets which are being moved to hashTable_
+    HashTable oldTable_;
+
+    /// @brief Shift of the previous buckets
+    unsigned oldShift_;
+
+    /// @brief Count of the previous buckets already moved to hashTable_
+    size_t migrated_;
+
+    /// @brief Count of items in the table
+    size_t size_;
+
+    /// @brief Initial count of buckets, table never shrinks below it
+    size_t minBuckets_;
+
+    /// @brief Hash function
+    HashFunction hasher_;
+
+    /// @brief Maps the key to the bucket
+    size_t hash(const Key & k) const { return fibonacciIndex(hasher_(k), shift_); }
+
+    /// @brief Returns the chain where the key lives or has to be put
+    const Chain & chainOf(const Key & k) const;
+    Chain & chainOf(const Key & k) { return const_cast<Chain &>(static_cast<const HashTableChaining *>(this)->chainOf(k)); }
+
+    /// @brief Returns count of previous and current buckets
+    size_t bucketsTotal() const { return oldTable_.size() + hashTable_.size(); }
+
+    /// @brief Returns bucket by index counting previous buckets first
+    const Chain & bucket(size_t i) const
+    {
+        return i < oldTable_.size() ? oldTable_[i] : hashTable_[i - oldTable_.size()];
+    }
+
+    /// @brief Starts rehashing if load factor is out of bounds and no rehashing is in progress
+    void resize();
+
+    /// @brief Starts moving items into the new buckets of the given count
+    void startRehash(size_t buckets);
+
+    /// @brief Moves next REHASH_STEP previous buckets into hashTable_
+    void rehashStep();
 
     /// @brief Comparator is used to find item by key
     class Comparator {
@@ -59,10 +245,11 @@ private:
     };
 };
 
-template<typename Key, typename Value>
-void HashTableChaining<Key, Value>::put(Key k, Value v)
+template<typename Key, typename Value, typename HashFunction>
+void HashTableChaining<Key, Value, HashFunction>::put(Key k, Value v)
 {
-    auto & chain = hashTable_[hash(k)];
+    rehashStep();
+    auto & chain = chainOf(k);
     auto it = std::find_if(chain.begin(), chain.end(), Comparator{k});
     if (it != chain.end())
     {
@@ -71,13 +258,15 @@ void HashTableChaining<Key, Value>::put(Key k, Value v)
     else
     {
         chain.push_back(std::pair<Key, Value>{k, v});
+        ++size_;
     }
+    resize();
 }
 
-template<typename Key, typename Value>
-Value HashTableChaining<Key, Value>::get(Key k) const
+template<typename Key, typename Value, typename HashFunction>
+Value HashTableChaining<Key, Value, HashFunction>::get(Key k) const
 {
-    const auto & chain = hashTable_[hash(k)];
+    const auto & chain = chainOf(k);
     auto it = std::find_if(chain.begin(), chain.end(), Comparator{k});
     if (it != chain.end())
     {
@@ -86,11 +275,167 @@ Value HashTableChaining<Key, Value>::get(Key k) const
     return Value{};
 }
 
-template<typename Key, typename Value>
-void HashTableChaining<Key, Value>::del(Key k)
+template<typename Key, typename Value, typename HashFunction>
+void HashTableChaining<Key, Value, HashFunction>::del(Key k)
 {
-    auto & chain = hashTable_[hash(k)];
-    chain.erase(std::remove_if(chain.begin(), chain.end(), Comparator{k}), chain.end());
+    rehashStep();
+    auto & chain = chainOf(k);
+    auto it = std::find_if(chain.begin(), chain.end(), Comparator{k});
+    if (it != chain.end())
+    {
+        chain.erase(it);
+        --size_;
+    }
+    resize();
+}
+
+template<typename Key, typename Value, typename HashFunction>
+template<typename ForwardIt>
+void HashTableChaining<Key, Value, HashFunction>::putAll(ForwardIt first, ForwardIt last)
+{
+    reserve(size_ + static_cast<size_t>(std::distance(first, last)));
+    for (; first != last; ++first)
+    {
+        auto & chain = hashTable_[hash(first->first)];
+        auto it = std::find_if(chain.begin(), chain.end(), Comparator{first->first});
+        if (it != chain.end())
+        {
+            (*it).second = first->second;
+        }
+        else
+        {
+            chain.emplace_back(first->first, first->second);
+            ++size_;
+        }
+    }
+}
+
+template<typename Key, typename Value, typename HashFunction>
+void HashTableChaining<Key, Value, HashFunction>::reserve(size_t count)
+{
+    size_t buckets = std::max(powerOfTwo(count), hashTable_.size());
+    if (buckets == hashTable_.size() && !rehashing())
+    {
+        return;
+    }
+
+    if (buckets != hashTable_.size())
+    {
+        HashTable previous(buckets);
+        previous.swap(hashTable_);
+        shift_ = fibonacciShift(buckets);
+        for (auto & chain : previous)
+        {
+            while (!chain.empty())
+            {
+                auto & target = hashTable_[hash(chain.front().first)];
+                target.splice(target.end(), chain, chain.begin());
+            }
+        }
+    }
+
+    for (; migrated_ < oldTable_.size(); ++migrated_)
+    {
+        auto & chain = oldTable_[migrated_];
+        while (!chain.empty())
+        {
+            auto & target = hashTable_[hash(chain.front().first)];
+            target.splice(target.end(), chain, chain.begin());
+        }
+    }
+    HashTable().swap(oldTable_);
+}
+
+template<typename Key, typename Value, typename HashFunction>
+HashTableStats HashTableChaining<Key, Value, HashFunction>::stats() const
+{
+    HashTableStats stats{size_, bucketsTotal(), 0, loadFactor(), 0, 0.0, 0.0, 0};
+    size_t probes = 0;
+    for (size_t i = 0; i < bucketsTotal(); ++i)
+    {
+        size_t length = bucket(i).size();
+        if (length > 0)
+        {
+            ++stats.usedBuckets;
+            stats.maxChain = std::max(stats.maxChain, length);
+            // i-th item of the chain is found after i comparisons
+            probes += length * (length + 1) / 2;
+        }
+    }
+
+    if (stats.usedBuckets > 0)
+    {
+        stats.avgChain = static_cast<double>(size_) / stats.usedBuckets;
+        stats.avgProbes = static_cast<double>(probes) / size_;
+    }
+
+    // list node holds the item and two pointers
+    stats.bytes = sizeof(*this) + bucketsTotal() * sizeof(Chain)
+                + size_ * (sizeof(std::pair<Key, Value>) + 2 * sizeof(void *));
+    return stats;
+}
+
+template<typename Key, typename Value, typename HashFunction>
+const typename HashTableChaining<Key, Value, HashFunction>::Chain &
+HashTableChaining<Key, Value, HashFunction>::chainOf(const Key & k) const
+{
+    if (rehashing())
+    {
+        size_t oldIndex = fibonacciIndex(hasher_(k), oldShift_);
+        if (oldIndex >= migrated_)
+        {
+            return oldTable_[oldIndex];
+        }
+    }
+    return hashTable_[hash(k)];
+}
+
+template<typename Key, typename Value, typename HashFunction>
+void HashTableChaining<Key, Value, HashFunction>::resize()
+{
+    if (rehashing())
+    {
+        return;
+    }
+
+    if (size_ > hashTable_.size())
+    {
+        startRehash(hashTable_.size() * 2);
+    }
+    else if (size_ * 8 < hashTable_.size() && hashTable_.size() > minBuckets_)
+    {
+        startRehash(hashTable_.size() / 2);
+    }
+}
+
+template<typename Key, typename Value, typename HashFunction>
+void HashTableChaining<Key, Value, HashFunction>::startRehash(size_t buckets)
+{
+    oldTable_.swap(hashTable_);
+    oldShift_ = shift_;
+    hashTable_ = HashTable(buckets);
+    shift_ = fibonacciShift(buckets);
+    migrated_ = 0;
+}
+
+template<typename Key, typename Value, typename HashFunction>
+void HashTableChaining<Key, Value, HashFunction>::rehashStep()
+{
+    for (size_t step = 0; step < REHASH_STEP && rehashing(); ++step)
+    {
+        auto & chain = oldTable_[migrated_];
+        while (!chain.empty())
+        {
+            // splice relinks the node without copying the item
+            auto & target = hashTable_[hash(chain.front().first)];
+            target.splice(target.end(), chain, chain.begin());
+        }
+
+        if (++migrated_ == oldTable_.size())
+        {
+            HashTable().swap(oldTable_);
+        }
+    }
 }
 
 } // namespace hash
@@ -0,0 +1,163 @@
+/**
+ * @author Volodymyr Lotoshko (vlotoshko@gmail.com)
+ * @date 19-Oct-2026
+ */
+
+//--------------------------------------------------------------------------------------------------
+#ifndef HASH_TABLE_CONCURRENT_HPP
+#define HASH_TABLE_CONCURRENT_HPP
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+#include "HashTableChaining.hpp"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+//--------------------------------------------------------------------------------------------------
+
+namespace hash
+{
+
+/**
+ * @class HashTableConcurrent
+ * @brief The HashTableConcurrent class is the hash table which can be used by many threads at
+ * once. Items are split between shards, every shard is HashTableChaining guarded by its own
+ * mutex, so threads working with different shards do not wait for each other.
+ * @tparam Key key type of the table
+ * @tparam Value value type of the table
+ * @tparam HashFunction functor which maps key to size_t
+ *
+ * Shard is chosen by the low bits of the hash, while HashTableChaining chooses the bucket
+ * by the high bits of the Fibonacci hash, so items are spread well inside every shard.
+ */
+template<typename Key, typename Value, typename HashFunction = Hasher<Key>>
+class HashTableConcurrent
+{
+public:
+    /**
+     * @brief The HashTableConcurrent constructor.
+     * @param[in] size total count of the buckets
+     * @param[in] shards count of the shards, rounded up to power of two
+     */
+    explicit HashTableConcurrent(size_t size, size_t shards = 64);
+
+    /// @brief Puts new value into the table.
+    void put(Key k, Value v);
+
+    /// @brief Gets value from the table.
+    Value get(Key k) const;
+
+    /**
+     * @brief Gets values of many keys, locking every involved shard only once.
+     * @param[in] keys keys to look for
+     * @return values in the order of the keys, value-initialized values for absent keys.
+     */
+    std::vector<Value> get(const std::vector<Key> & keys) const;
+
+    /// @brief Deletes item with the given key.
+    void del(Key k);
+
+    /// @brief Returns count of the shards.
+    size_t shards() const { return shards_.size(); }
+
+private:
+    /// @brief Part of the table guarded by its own mutex
+    struct Shard
+    {
+        explicit Shard(size_t size) : mutex(), table(size) {}
+        mutable std::mutex mutex;
+        HashTableChaining<Key, Value, HashFunction> table;
+    };
+
+    /// @brief Shards of the table, count is power of two
+    std::vector<std::unique_ptr<Shard>> shards_;
+
+    /// @brief Hash function
+    HashFunction hasher_;
+
+    /// @brief Chooses the shard of the key
+    size_t shardOf(const Key & k) const { return hasher_(k) & (shards_.size() - 1); }
+};
+
+template<typename Key, typename Value, typename HashFunction>
+HashTableConcurrent<Key, Value, HashFunction>::HashTableConcurrent(size_t size, size_t shards)
+    : shards_(), hasher_()
+{
+    shards = powerOfTwo(shards);
+    shards_.reserve(shards);
+    for (size_t i = 0; i < shards; ++i)
+    {
+        shards_.emplace_back(new Shard((size + shards - 1) / shards));
+    }
+}
+
+template<typename Key, typename Value, typename HashFunction>
+void HashTableConcurrent<Key, Value, HashFunction>::put(Key k, Value v)
+{
+    auto & shard = *shards_[shardOf(k)];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.table.put(std::move(k), std::move(v));
+}
+
+template<typename Key, typename Value, typename HashFunction>
+Value HashTableConcurrent<Key, Value, HashFunction>::get(Key k) const
+{
+    auto & shard = *shards_[shardOf(k)];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.table.get(std::move(k));
+}
+
+template<typename Key, typename Value, typename HashFunction>
+std::vector<Value> HashTableConcurrent<Key, Value, HashFunction>::get(const std::vector<Key> & keys) const
+{
+    // counting sort of the keys' indexes by their shards
+    std::vector<size_t> shardOfKey(keys.size());
+    std::vector<size_t> starts(shards_.size() + 1, 0);
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        shardOfKey[i] = shardOf(keys[i]);
+        ++starts[shardOfKey[i] + 1];
+    }
+    for (size_t s = 0; s < shards_.size(); ++s)
+    {
+        starts[s + 1] += starts[s];
+    }
+
+    std::vector<size_t> order(keys.size());
+    std::vector<size_t> next(starts.begin(), starts.end() - 1);
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        order[next[shardOfKey[i]]++] = i;
+    }
+
+    std::vector<Value> values(keys.size());
+    for (size_t s = 0; s < shards_.size(); ++s)
+    {
+        if (starts[s] == starts[s + 1])
+        {
+            continue;
+        }
+        auto & shard = *shards_[s];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (size_t j = starts[s]; j < starts[s + 1]; ++j)
+        {
+            values[order[j]] = shard.table.get(keys[order[j]]);
+        }
+    }
+    return values;
+}
+
+template<typename Key, typename Value, typename HashFunction>
+void HashTableConcurrent<Key, Value, HashFunction>::del(Key k)
+{
+    auto & shard = *shards_[shardOf(k)];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.table.del(std::move(k));
+}
+
+} // namespace hash
+
+//--------------------------------------------------------------------------------------------------
+#endif // HASH_TABLE_CONCURRENT_HPP
+//--------------------------------------------------------------------------------------------------
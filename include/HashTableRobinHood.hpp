@@ -0,0 +1,302 @@
+/**
+ * @author Volodymyr Lotoshko (vlotoshko@gmail.com)
+ * @date 19-Oct-2026
+ */
+
+//--------------------------------------------------------------------------------------------------
+#ifndef HASH_TABLE_ROBIN_HOOD_HPP
+#define HASH_TABLE_ROBIN_HOOD_HPP
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+#include "HashFunctions.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+//--------------------------------------------------------------------------------------------------
+
+namespace hash
+{
+
+/**
+ * @class HashTableRobinHood
+ * @brief The HashTableRobinHood class is the hash table with the open addressing collision
+ * resolve and Robin Hood displacement.
+ * @tparam Key key type of the table
+ * @tparam Value value type of the table
+ * @tparam HashFunction functor which maps key to size_t
+ *
+ * Items are kept in one flat array, every slot has a one byte distance from its home slot
+ * (0 means empty slot). While inserting, the item which is further from its home takes the slot
+ * and the displaced item continues probing, so probe sequences stay short and lookup can stop
+ * as soon as it meets an item closer to home than the searched key would be. Deleting shifts
+ * the following items back by one slot, so no tombstones are needed. The table doubles when
+ * load factor exceeds 7/8, or when some distance would overflow and load factor is at least 1/2.
+ * Overflow at lower load means that too many keys have close hashes, growth does not help then.
+ * Key and Value must be default constructible.
+ */
+template<typename Key, typename Value, typename HashFunction = Hasher<Key>>
+class HashTableRobinHood
+{
+public:
+    /// @brief The HashTableRobinHood constructor.
+    /// @param[in] size expected count of items, table is allocated to hold them without growth
+    explicit HashTableRobinHood(size_t size = 0);
+
+    /**
+     * @brief Puts new value into the table.
+     * @throws std::length_error if the item can not be placed because too many keys have close
+     * hashes (weak hash function), the item is not put then
+     */
+    void put(Key k, Value v);
+
+    /// @brief Gets value from the table.
+    Value get(Key k) const;
+
+    /// @brief Deletes item with the given key.
+    void del(Key k);
+
+    /// @brief Returns count of items in the table.
+    size_t size() const { return size_; }
+
+    /// @brief Returns count of slots in the table.
+    size_t capacity() const { return slots_.size(); }
+
+    /// @brief Returns ratio between count of items and count of slots.
+    double loadFactor() const { return static_cast<double>(size_) / capacity(); }
+
+private:
+    /// @brief Slot of the table
+    struct Slot
+    {
+        Key   key;
+        Value value;
+    };
+
+    /// @brief EMPTY distance marks the empty slot, distances are less than MAX_DISTANCE
+    enum : uint8_t { EMPTY = 0, MAX_DISTANCE = 255 };
+
+    /// @brief Slots of the table, count is power of two
+    std::vector<Slot> slots_;
+
+    /// @brief 1 + distance of the item from its home slot, or EMPTY
+    std::vector<uint8_t> distances_;
+
+    /// @brief Count of items in the table
+    size_t size_;
+
+    /// @brief Shift which leaves log2(capacity) high bits of the 64-bit hash
+    unsigned shift_;
+
+    /// @brief Hash function
+    HashFunction hasher_;
+
+    /// @brief Fibonacci hashing maps hash to the home slot using its high bits
+    size_t home(const Key & k) const { return fibonacciIndex(hasher_(k), shift_); }
+
+    /// @brief Returns index of the slot with the given key or capacity() if key is absent
+    size_t find(const Key & k) const;
+
+    /// @brief Inserts the item which is known to be absent, returns false and changes nothing
+    /// if some distance would reach MAX_DISTANCE
+    bool insert(Slot & slot);
+
+    /**
+     * @brief Takes the slot for the new item with the given home slot: items from the place up to
+     * the empty slot move one slot further.
+     * @param[in, out] distances distances of the slots
+     * @param[in] home home slot of the new item
+     * @param[in] move function object (to, from) which moves the item between the slots
+     * @return the taken slot, or distances.size() without changes if some distance would reach
+     * MAX_DISTANCE
+     */
+    template<typename Move>
+    static size_t place(std::vector<uint8_t> & distances, size_t home, Move move);
+
+    /// @brief Allocates the given count of empty slots and reinserts all items, the table is not
+    /// changed if some item can not be placed
+    void rehash(size_t capacity);
+};
+
+template<typename Key, typename Value, typename HashFunction>
+HashTableRobinHood<Key, Value, HashFunction>::HashTableRobinHood(size_t size)
+    : slots_(), distances_(), size_(0), shift_(64), hasher_()
+{
+    size_t capacity = 8;
+    while (capacity * 7 < size * 8)
+    {
+        capacity *= 2;
+    }
+    rehash(capacity);
+}
+
+template<typename Key, typename Value, typename HashFunction>
+void HashTableRobinHood<Key, Value, HashFunction>::put(Key k, Value v)
+{
+    size_t i = find(k);
+    if (i != capacity())
+    {
+        slots_[i].value = std::move(v);
+        return;
+    }
+
+    if ((size_ + 1) * 8 > capacity() * 7)
+    {
+        rehash(capacity() * 2);
+    }
+
+    Slot slot{std::move(k), std::move(v)};
+    if (insert(slot))
+    {
+        return;
+    }
+    if (size_ * 2 >= capacity())
+    {
+        rehash(capacity() * 2);
+        if (insert(slot))
+        {
+            return;
+        }
+    }
+    throw std::length_error("HashTableRobinHood: too many keys with close hashes");
+}
+
+template<typename Key, typename Value, typename HashFunction>
+Value HashTableRobinHood<Key, Value, HashFunction>::get(Key k) const
+{
+    size_t i = find(k);
+    return i != capacity() ? slots_[i].value : Value{};
+}
+
+template<typename Key, typename Value, typename HashFunction>
+void HashTableRobinHood<Key, Value, HashFunction>::del(Key k)
+{
+    size_t i = find(k);
+    if (i == capacity())
+    {
+        return;
+    }
+
+    // backward shift: items after the deleted one move one slot closer to their home
+    const size_t mask = capacity() - 1;
+    size_t next = (i + 1) & mask;
+    while (distances_[next] > 1)
+    {
+        slots_[i] = std::move(slots_[next]);
+        distances_[i] = distances_[next] - 1;
+        i = next;
+        next = (next + 1) & mask;
+    }
+    slots_[i] = Slot{};
+    distances_[i] = EMPTY;
+    --size_;
+}
+
+template<typename Key, typename Value, typename HashFunction>
+size_t HashTableRobinHood<Key, Value, HashFunction>::find(const Key & k) const
+{
+    const size_t mask = capacity() - 1;
+    size_t i = home(k);
+    for (unsigned distance = 1; distances_[i] >= distance; ++distance)
+    {
+        if (distances_[i] == distance && slots_[i].key == k)
+        {
+            return i;
+        }
+        i = (i + 1) & mask;
+    }
+    return capacity();
+}
+
+template<typename Key, typename Value, typename HashFunction>
+bool HashTableRobinHood<Key, Value, HashFunction>::insert(Slot & slot)
+{
+    size_t i = place(distances_, home(slot.key), [this](size_t to, size_t from) { slots_[to] = std::move(slots_[from]); });
+    if (i == capacity())
+    {
+        return false;
+    }
+    slots_[i] = std::move(slot);
+    ++size_;
+    return true;
+}
+
+template<typename Key, typename Value, typename HashFunction>
+template<typename Move>
+size_t HashTableRobinHood<Key, Value, HashFunction>::place(std::vector<uint8_t> & distances, size_t home, Move move)
+{
+    // 1. the item takes the first slot whose item is closer to its home than the new one would be
+    const size_t mask = distances.size() - 1;
+    size_t place = home;
+    unsigned distance = 1;
+    while (distances[place] != EMPTY && distances[place] >= distance)
+    {
+        if (++distance == MAX_DISTANCE)
+        {
+            return distances.size();
+        }
+        place = (place + 1) & mask;
+    }
+
+    // 2. items from there up to the empty slot move one slot further
+    size_t last = place;
+    while (distances[last] != EMPTY)
+    {
+        if (distances[last] + 1 == MAX_DISTANCE)
+        {
+            return distances.size();
+        }
+        last = (last + 1) & mask;
+    }
+    for (size_t i = last; i != place; i = (i - 1) & mask)
+    {
+        move(i, (i - 1) & mask);
+        distances[i] = static_cast<uint8_t>(distances[(i - 1) & mask] + 1);
+    }
+    distances[place] = static_cast<uint8_t>(distance);
+    return place;
+}
+
+template<typename Key, typename Value, typename HashFunction>
+void HashTableRobinHood<Key, Value, HashFunction>::rehash(size_t capacity)
+{
+    // 1. new places are found for the indices of the items, so failure changes nothing
+    const unsigned shift = fibonacciShift(capacity);
+    std::vector<uint8_t> distances(capacity, EMPTY);
+    std::vector<size_t> sources(capacity);
+    for (size_t i = 0; i < slots_.size(); ++i)
+    {
+        if (distances_[i] == EMPTY)
+        {
+            continue;
+        }
+        size_t j = place(distances, fibonacciIndex(hasher_(slots_[i].key), shift),
+                         [&sources](size_t to, size_t from) { sources[to] = sources[from]; });
+        if (j == capacity)
+        {
+            throw std::length_error("HashTableRobinHood: too many keys with close hashes");
+        }
+        sources[j] = i;
+    }
+
+    // 2. items move to their places
+    std::vector<Slot> slots(capacity);
+    for (size_t j = 0; j < capacity; ++j)
+    {
+        if (distances[j] != EMPTY)
+        {
+            slots[j] = std::move(slots_[sources[j]]);
+        }
+    }
+    slots_.swap(slots);
+    distances_.swap(distances);
+    shift_ = shift;
+}
+
+} // namespace hash
+
+//--------------------------------------------------------------------------------------------------
+#endif // HASH_TABLE_ROBIN_HOOD_HPP
+//--------------------------------------------------------------------------------------------------
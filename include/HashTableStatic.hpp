@@ -0,0 +1,408 @@
+/**
+ * @author Volodymyr Lotoshko (vlotoshko@gmail.com)
+ * @date 19-Oct-2026
+ */
+
+//--------------------------------------------------------------------------------------------------
+#ifndef HASH_TABLE_STATIC_HPP
+#define HASH_TABLE_STATIC_HPP
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+#include "HashFunctions.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+//--------------------------------------------------------------------------------------------------
+
+namespace hash
+{
+
+/**
+ * @class HashTableStatic
+ * @brief The HashTableStatic class is the read-only hash table over a minimal perfect hash
+ * function, stored in a flat file and queried right from the memory-mapped file.
+ * @tparam Key key type of the table, must be trivially copyable
+ * @tparam Value value type of the table, must be trivially copyable
+ * @tparam HashFunction functor which maps key to size_t, must give the same results in the
+ * process which builds the file and in processes which read it
+ *
+ * The perfect hash is built by hash-and-displace method (PTHash, CHD): keys are split into
+ * buckets of ~4 keys, buckets are placed from the biggest one, and for every bucket the
+ * smallest pilot is searched such that (hash ^ mix64(pilot)) % count sends all keys of the
+ * bucket to distinct free slots. Only the pilots (4 bytes per bucket) are stored besides the
+ * items themselves, so lookup is one bucket read and one slot read.
+ *
+ * File layout: Header, uint32_t pilots[buckets] padded to 8 bytes, Entry entries[count].
+ */
+template<typename Key, typename Value, typename HashFunction = Hasher<Key>>
+class HashTableStatic
+{
+    static_assert(std::is_trivially_copyable<Key>::value, "HashTableStatic requires trivially copyable key");
+    static_assert(std::is_trivially_copyable<Value>::value, "HashTableStatic requires trivially copyable value");
+
+public:
+    /**
+     * @brief Builds the perfect hash table of the given items and writes it to the file.
+     * @tparam ForwardIt forward iterator of the pairs key-value, e.g. HashTableChaining iterator
+     * @param[in] first beginning of the items
+     * @param[in] last end of the items
+     * @param[in] fileName name of the file to write
+     * @throws std::invalid_argument if keys are not unique
+     * @throws std::runtime_error if the hash function gives the same value for distinct keys, the
+     * perfect hash is not found with MAX_ATTEMPTS seeds or the file can not be written
+     */
+    template<typename ForwardIt>
+    static void build(ForwardIt first, ForwardIt last, const std::string & fileName);
+
+    /**
+     * @brief The HashTableStatic constructor maps the file written by build into memory, the file
+     * is read into the memory where mmap is not available.
+     * @param[in] fileName name of the file
+     * @throws std::runtime_error if the file can not be mapped or has wrong format
+     */
+    explicit HashTableStatic(const std::string & fileName);
+    ~HashTableStatic();
+
+    HashTableStatic(const HashTableStatic &) = delete;
+    HashTableStatic & operator= (const HashTableStatic &) = delete;
+
+    /// @brief Gets value from the table.
+    Value get(const Key & k) const { const Entry * e = find(k); return e ? e->value : Value{}; }
+
+    /// @brief Defines whether the table contains the key.
+    bool contains(const Key & k) const { return find(k) != nullptr; }
+
+    /// @brief Returns count of items in the table.
+    size_t size() const { return static_cast<size_t>(header_->count); }
+
+private:
+    /// @brief Beginning of the file
+    struct Header
+    {
+        uint64_t magic;
+        uint64_t count;
+        uint64_t buckets;
+        uint64_t seed;
+        uint64_t entrySize;
+    };
+
+    /// @brief Slot of the table
+    struct Entry
+    {
+        Key   key;
+        Value value;
+    };
+
+    static_assert(alignof(Entry) <= 8, "HashTableStatic requires entries aligned to 8 bytes at most");
+
+    /// @brief Mark of the file format
+    static const uint64_t MAGIC = 0x314854534853414Dull;
+
+    /// @brief Average count of keys in the bucket
+    static const uint64_t BUCKET_SIZE = 4;
+
+    /// @brief Count of pilots to try for one bucket before changing the seed
+    static const uint32_t MAX_PILOT = 1u << 24;
+
+    /// @brief Count of seeds to try before giving up
+    static const uint64_t MAX_ATTEMPTS = 32;
+
+    static uint64_t hashOf(const Key & k, uint64_t seed) { return mix64(HashFunction{}(k) ^ seed); }
+    static uint64_t bucketOf(uint64_t h, uint64_t buckets) { return (h >> 32) % buckets; }
+    static uint64_t slotOf(uint64_t h, uint32_t pilot, uint64_t count) { return (h ^ mix64(pilot)) % count; }
+    static size_t pilotsBytes(uint64_t buckets) { return static_cast<size_t>((buckets * sizeof(uint32_t) + 7) / 8 * 8); }
+
+    /// @brief Searches pilots for all buckets, returns false if some bucket can not be placed
+    static bool place(const std::vector<uint64_t> & hashes, uint64_t buckets,
+                      std::vector<uint32_t> & pilots, std::vector<size_t> & slots);
+
+    const Entry * find(const Key & k) const;
+
+    /// @brief Unmaps the file.
+    void unmap();
+
+    /// @brief Mapped file
+    void * data_;
+    /// @brief Size of the mapped file
+    size_t length_;
+    /// @brief Parts of the mapped file
+    const Header * header_;
+    const uint32_t * pilots_;
+    const Entry * entries_;
+#ifdef _WIN32
+    /// @brief Content of the file read into the memory
+    std::vector<uint64_t> content_;
+#endif
+};
+
+template<typename Key, typename Value, typename HashFunction>
+template<typename ForwardIt>
+void HashTableStatic<Key, Value, HashFunction>::build(ForwardIt first, ForwardIt last, const std::string & fileName)
+{
+    std::vector<Entry> items;
+    items.reserve(static_cast<size_t>(std::distance(first, last)));
+    for (; first != last; ++first)
+    {
+        items.push_back(Entry{first->first, first->second});
+    }
+
+    const uint64_t count = items.size();
+    const uint64_t buckets = std::max<uint64_t>((count + BUCKET_SIZE - 1) / BUCKET_SIZE, 1);
+    std::vector<uint64_t> hashes(items.size());
+    std::vector<uint32_t> pilots;
+    std::vector<size_t> slots;
+    uint64_t seed = 0;
+    for (uint64_t attempt = 1; ; ++attempt)
+    {
+        if (attempt > MAX_ATTEMPTS)
+        {
+            throw std::runtime_error("HashTableStatic: perfect hash is not found");
+        }
+
+        seed = mix64(attempt);
+        for (size_t i = 0; i < items.size(); ++i)
+        {
+            hashes[i] = hashOf(items[i].key, seed);
+        }
+        if (place(hashes, buckets, pilots, slots))
+        {
+            break;
+        }
+
+        // keys with equal results of HashFunction collide with every seed, so check them only
+        // after the first failure
+        if (attempt == 1)
+        {
+            std::vector<Key> keys;
+            std::vector<size_t> rawHashes;
+            for (auto const & item : items)
+            {
+                keys.push_back(item.key);
+                rawHashes.push_back(HashFunction{}(item.key));
+            }
+            std::sort(keys.begin(), keys.end());
+            if (std::adjacent_find(keys.begin(), keys.end()) != keys.end())
+            {
+                throw std::invalid_argument("HashTableStatic: keys are not unique");
+            }
+            std::sort(rawHashes.begin(), rawHashes.end());
+            if (std::adjacent_find(rawHashes.begin(), rawHashes.end()) != rawHashes.end())
+            {
+                throw std::runtime_error("HashTableStatic: hash function gives the same value for distinct keys");
+            }
+        }
+    }
+
+    std::vector<Entry> entries(items.size());
+    for (size_t i = 0; i < items.size(); ++i)
+    {
+        entries[slots[i]] = items[i];
+    }
+
+    Header header{MAGIC, count, buckets, seed, sizeof(Entry)};
+    std::vector<char> pilotsData(pilotsBytes(buckets), 0);
+    std::copy_n(reinterpret_cast<const char *>(pilots.data()), pilots.size() * sizeof(uint32_t), pilotsData.begin());
+
+    std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(pilotsData.data(), static_cast<std::streamsize>(pilotsData.size()));
+    file.write(reinterpret_cast<const char *>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(Entry)));
+    if (!file)
+    {
+        throw std::runtime_error("HashTableStatic: can not write " + fileName);
+    }
+}
+
+template<typename Key, typename Value, typename HashFunction>
+bool HashTableStatic<Key, Value, HashFunction>::place(const std::vector<uint64_t> & hashes, uint64_t buckets,
+                                                      std::vector<uint32_t> & pilots, std::vector<size_t> & slots)
+{
+    const uint64_t count = hashes.size();
+    pilots.assign(static_cast<size_t>(buckets), 0);
+    slots.assign(hashes.size(), 0);
+    if (count == 0)
+    {
+        return true;
+    }
+
+    // keys grouped by buckets: counting sort of the keys' indexes
+    std::vector<size_t> starts(static_cast<size_t>(buckets) + 1, 0);
+    for (auto const & h : hashes)
+    {
+        ++starts[bucketOf(h, buckets) + 1];
+    }
+    for (size_t b = 0; b < buckets; ++b)
+    {
+        starts[b + 1] += starts[b];
+    }
+    std::vector<size_t> keys(hashes.size());
+    std::vector<size_t> next(starts.begin(), starts.end() - 1);
+    for (size_t i = 0; i < hashes.size(); ++i)
+    {
+        keys[next[bucketOf(hashes[i], buckets)]++] = i;
+    }
+
+    std::vector<size_t> order(static_cast<size_t>(buckets));
+    for (size_t b = 0; b < order.size(); ++b)
+    {
+        order[b] = b;
+    }
+    std::stable_sort(order.begin(), order.end(), [&starts](size_t a, size_t b) {
+        return starts[a + 1] - starts[a] > starts[b + 1] - starts[b];
+    });
+
+    std::vector<bool> taken(static_cast<size_t>(count), false);
+    std::vector<size_t> candidate;
+    for (auto const & b : order)
+    {
+        if (starts[b] == starts[b + 1])
+        {
+            break;
+        }
+
+        // equal hashes can not be separated by any pilot
+        for (size_t j = starts[b]; j < starts[b + 1]; ++j)
+        {
+            for (size_t i = starts[b]; i < j; ++i)
+            {
+                if (hashes[keys[i]] == hashes[keys[j]])
+                {
+                    return false;
+                }
+            }
+        }
+
+        bool placed = false;
+        for (uint32_t pilot = 0; pilot < MAX_PILOT && !placed; ++pilot)
+        {
+            candidate.clear();
+            placed = true;
+            for (size_t j = starts[b]; j < starts[b + 1] && placed; ++j)
+            {
+                size_t slot = static_cast<size_t>(slotOf(hashes[keys[j]], pilot, count));
+                placed = !taken[slot] && std::find(candidate.begin(), candidate.end(), slot) == candidate.end();
+                candidate.push_back(slot);
+            }
+
+            if (placed)
+            {
+                pilots[b] = pilot;
+                for (size_t j = starts[b]; j < starts[b + 1]; ++j)
+                {
+                    slots[keys[j]] = candidate[j - starts[b]];
+                    taken[candidate[j - starts[b]]] = true;
+                }
+            }
+        }
+
+        if (!placed)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename Key, typename Value, typename HashFunction>
+HashTableStatic<Key, Value, HashFunction>::HashTableStatic(const std::string & fileName)
+    : data_(nullptr), length_(0), header_(nullptr), pilots_(nullptr), entries_(nullptr)
+{
+#ifndef _WIN32
+    int fd = ::open(fileName.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw std::runtime_error("HashTableStatic: can not open " + fileName);
+    }
+
+    void * data = MAP_FAILED;
+    struct stat info;
+    if (::fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) >= sizeof(Header))
+    {
+        length_ = static_cast<size_t>(info.st_size);
+        data = ::mmap(nullptr, length_, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (data == MAP_FAILED)
+    {
+        throw std::runtime_error("HashTableStatic: can not map " + fileName);
+    }
+    data_ = data;
+#else
+    std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+    if (!file)
+    {
+        throw std::runtime_error("HashTableStatic: can not open " + fileName);
+    }
+
+    // uint64_t keeps the parts of the file aligned as in the mapped memory
+    length_ = static_cast<size_t>(file.tellg());
+    content_.resize((length_ + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+    file.seekg(0);
+    if (length_ < sizeof(Header) || !file.read(reinterpret_cast<char *>(content_.data()), static_cast<std::streamsize>(length_)))
+    {
+        throw std::runtime_error("HashTableStatic: can not read " + fileName);
+    }
+    data_ = content_.data();
+#endif
+
+    header_ = static_cast<const Header *>(data_);
+    const size_t expected = sizeof(Header) + pilotsBytes(header_->buckets) + header_->count * sizeof(Entry);
+    if (header_->magic != MAGIC || header_->entrySize != sizeof(Entry) || header_->buckets == 0 || length_ != expected)
+    {
+        unmap();
+        throw std::runtime_error("HashTableStatic: wrong format of " + fileName);
+    }
+
+    auto bytes = static_cast<const char *>(data_);
+    pilots_ = reinterpret_cast<const uint32_t *>(bytes + sizeof(Header));
+    entries_ = reinterpret_cast<const Entry *>(bytes + sizeof(Header) + pilotsBytes(header_->buckets));
+}
+
+template<typename Key, typename Value, typename HashFunction>
+HashTableStatic<Key, Value, HashFunction>::~HashTableStatic()
+{
+    unmap();
+}
+
+template<typename Key, typename Value, typename HashFunction>
+void HashTableStatic<Key, Value, HashFunction>::unmap()
+{
+#ifndef _WIN32
+    ::munmap(data_, length_);
+#endif
+}
+
+template<typename Key, typename Value, typename HashFunction>
+const typename HashTableStatic<Key, Value, HashFunction>::Entry *
+HashTableStatic<Key, Value, HashFunction>::find(const Key & k) const
+{
+    if (header_->count == 0)
+    {
+        return nullptr;
+    }
+
+    uint64_t h = hashOf(k, header_->seed);
+    uint32_t pilot = pilots_[bucketOf(h, header_->buckets)];
+    const Entry & entry = entries_[slotOf(h, pilot, header_->count)];
+    return entry.key == k ? &entry : nullptr;
+}
+
+} // namespace hash
+
+//--------------------------------------------------------------------------------------------------
+#endif // HASH_TABLE_STATIC_HPP
+//--------------------------------------------------------------------------------------------------
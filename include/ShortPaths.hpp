@@ -12,6 +12,7 @@
 #include "Graph.hpp"
 #include "IndexedPQ.hpp"
 
+#include <limits>
 #include <vector>
 // -------------------------------------------------------------------------------------------------
 
@@ -0,0 +1,335 @@
+/**
+ * @author Volodymyr Lotoshko (vlotoshko@gmail.com)
+ * @date 19-Oct-2026
+ */
+
+//--------------------------------------------------------------------------------------------------
+#ifndef SKIP_LIST_CONCURRENT_HPP
+#define SKIP_LIST_CONCURRENT_HPP
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+#include <atomic>
+#include <new>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+//--------------------------------------------------------------------------------------------------
+
+namespace bst // binary search tree
+{
+
+/**
+ * @class SkipListConcurrent
+ * @brief The SkipListConcurrent class is the lock-free ordered map which can be filled by many
+ * threads at once.
+ * @tparam Key key type of the map
+ * @tparam Value value type of the map, must be trivially copyable
+ *
+ * Every node is linked into the sorted list of the level 0 and, with probability 1/2 per level,
+ * into the lists of the upper levels, which are used as express lanes while searching. New node
+ * becomes visible when it is linked into the level 0 by compare-and-swap, then it is linked into
+ * the upper levels one by one, the search of predecessors is repeated when some thread links
+ * another node next to it. Value of the existing key is replaced atomically. Items are not
+ * deleted, so readers never meet freed nodes and no memory reclamation is needed. Readers see
+ * every item which was put before they started, iteration is weakly consistent.
+ */
+template<typename Key, typename Value>
+class SkipListConcurrent
+{
+    static_assert(std::is_trivially_copyable<Value>::value, "SkipListConcurrent: value must be trivially copyable");
+
+public:
+    /// @brief The SkipListConcurrent default constructor.
+    SkipListConcurrent();
+    ~SkipListConcurrent();
+
+    SkipListConcurrent(const SkipListConcurrent &) = delete;
+    SkipListConcurrent & operator= (const SkipListConcurrent &) = delete;
+
+    /// @brief Puts new element into the map, replaces value of the existing key.
+    void put(const Key & k, Value v);
+
+    /// @brief Gets value by key, value-initialized value if key is absent.
+    Value get(const Key & k) const;
+
+    /// @brief Defines whether the map contains the key.
+    bool contains(const Key & k) const { return findEqual_(k) != nullptr; }
+
+    /// @brief Returns count of elements in the map.
+    size_t size() const { return size_.load(std::memory_order_relaxed); }
+
+    /// @brief Gets the largest key not greater than given, nullptr if there is no such key.
+    const Key * floor(const Key & k) const;
+
+    /// @brief Gets the smallest key not less than given, nullptr if there is no such key.
+    const Key * ceiling(const Key & k) const;
+
+    /// @brief Returns sorted keys within lo-hi interval.
+    std::vector<Key> keys(const Key & lo, const Key & hi) const;
+
+    /**
+     * @brief Calls the function for every item within lo-hi interval in the order of keys.
+     * @param[in] lo low boundary of the interval
+     * @param[in] hi high boundary of the interval
+     * @param[in] f function called as f(key, value)
+     */
+    template<typename Function>
+    void forEach(const Key & lo, const Key & hi, Function f) const;
+
+    /**
+     * @brief Defines whether every level is sorted and links every node which is high enough for
+     * it. It should not be called while other threads put items.
+     */
+    bool isConsistent() const;
+
+private:
+    /// @brief Max count of levels
+    enum : unsigned { MAX_LEVEL = 32 };
+
+    struct Node;
+    using Link = std::atomic<Node *>;
+
+    /// @brief Node of the list, its links to the next nodes of every level follow it in memory
+    struct Node
+    {
+        Node(const Key & k, Value v, unsigned h) : key(k), val(v), height(h) {}
+        Key                key;
+        std::atomic<Value> val;
+        unsigned           height;
+
+        static size_t linksOffset() { return (sizeof(Node) + alignof(Link) - 1) / alignof(Link) * alignof(Link); }
+        Link * links() { return reinterpret_cast<Link *>(reinterpret_cast<char *>(this) + linksOffset()); }
+        const Link * links() const { return reinterpret_cast<const Link *>(reinterpret_cast<const char *>(this) + linksOffset()); }
+    };
+
+    Link head_[MAX_LEVEL];       // First nodes of every level
+    std::atomic<size_t> size_;   // Count of items
+
+    static Node * create_(const Key & k, Value v, unsigned height);
+    static void destroy_(Node * n);
+    static unsigned randomHeight_();
+
+    /// @brief Links of the nodes at every level of the given node
+    const Link * links_(const Node * n) const { return n ? n->links() : head_; }
+
+    /// @brief Finds the link to the first node with key not less than k at every level.
+    void findPredecessors_(const Key & k, Link * preds[], Node * succs[]);
+
+    /// @brief Returns the last node with key less than k (or not greater if inclusive), or nullptr.
+    const Node * findLast_(const Key & k, bool inclusive) const;
+
+    /// @brief Returns the node with the key k or nullptr.
+    const Node * findEqual_(const Key & k) const;
+};
+
+// ----- SkipListConcurrent -----
+
+template<typename Key, typename Value>
+SkipListConcurrent<Key, Value>::SkipListConcurrent()
+    : size_(0)
+{
+    for (auto & link : head_)
+        link.store(nullptr, std::memory_order_relaxed);
+}
+
+template<typename Key, typename Value>
+SkipListConcurrent<Key, Value>::~SkipListConcurrent()
+{
+    Node * n = head_[0].load(std::memory_order_relaxed);
+    while (n != nullptr)
+    {
+        Node * next = n->links()[0].load(std::memory_order_relaxed);
+        destroy_(n);
+        n = next;
+    }
+}
+
+template<typename Key, typename Value>
+void SkipListConcurrent<Key, Value>::put(const Key & k, Value v)
+{
+    Link * preds[MAX_LEVEL];
+    Node * succs[MAX_LEVEL];
+    Node * n = nullptr;
+
+    // link into the level 0, after that the node is visible
+    while (true)
+    {
+        findPredecessors_(k, preds, succs);
+        if (succs[0] != nullptr && !(k < succs[0]->key))
+        {
+            if (n != nullptr)
+                destroy_(n);
+            succs[0]->val.store(v, std::memory_order_release);
+            return;
+        }
+
+        if (n == nullptr)
+            n = create_(k, v, randomHeight_());
+        for (unsigned i = 0; i < n->height; ++i)
+            n->links()[i].store(succs[i], std::memory_order_relaxed);
+
+        Node * expected = succs[0];
+        if (preds[0]->compare_exchange_strong(expected, n, std::memory_order_release, std::memory_order_relaxed))
+            break;
+    }
+    size_.fetch_add(1, std::memory_order_relaxed);
+
+    // link into the upper levels, the link of the node is set to the expected successor before
+    // every attempt, because successors found before may be stale
+    for (unsigned i = 1; i < n->height; ++i)
+    {
+        while (true)
+        {
+            Node * expected = succs[i];
+            n->links()[i].store(expected, std::memory_order_relaxed);
+            if (preds[i]->compare_exchange_strong(expected, n, std::memory_order_release, std::memory_order_relaxed))
+                break;
+
+            findPredecessors_(k, preds, succs);
+        }
+    }
+}
+
+template<typename Key, typename Value>
+Value SkipListConcurrent<Key, Value>::get(const Key & k) const
+{
+    const Node * n = findEqual_(k);
+    return n ? n->val.load(std::memory_order_acquire) : Value{};
+}
+
+template<typename Key, typename Value>
+const Key * SkipListConcurrent<Key, Value>::floor(const Key & k) const
+{
+    const Node * n = findLast_(k, true);
+    return n ? &n->key : nullptr;
+}
+
+template<typename Key, typename Value>
+const Key * SkipListConcurrent<Key, Value>::ceiling(const Key & k) const
+{
+    const Node * n = links_(findLast_(k, false))[0].load(std::memory_order_acquire);
+    return n ? &n->key : nullptr;
+}
+
+template<typename Key, typename Value>
+std::vector<Key> SkipListConcurrent<Key, Value>::keys(const Key & lo, const Key & hi) const
+{
+    std::vector<Key> vec;
+    forEach(lo, hi, [&vec](const Key & k, const Value &) { vec.push_back(k); });
+    return vec;
+}
+
+template<typename Key, typename Value>
+template<typename Function>
+void SkipListConcurrent<Key, Value>::forEach(const Key & lo, const Key & hi, Function f) const
+{
+    const Node * n = links_(findLast_(lo, false))[0].load(std::memory_order_acquire);
+    for (; n != nullptr && !(hi < n->key); n = n->links()[0].load(std::memory_order_acquire))
+        f(n->key, n->val.load(std::memory_order_acquire));
+}
+
+template<typename Key, typename Value>
+bool SkipListConcurrent<Key, Value>::isConsistent() const
+{
+    // walking the level 0, every node should be the next one of every level it belongs to
+    const Node * next[MAX_LEVEL];
+    for (unsigned i = 0; i < MAX_LEVEL; ++i)
+        next[i] = head_[i].load(std::memory_order_acquire);
+
+    const Node * prev = nullptr;
+    for (const Node * n = next[0]; n != nullptr; n = n->links()[0].load(std::memory_order_acquire))
+    {
+        if (prev != nullptr && !(prev->key < n->key))
+            return false;
+        for (unsigned i = 0; i < n->height; ++i)
+        {
+            if (next[i] != n)
+                return false;
+            next[i] = n->links()[i].load(std::memory_order_acquire);
+        }
+        prev = n;
+    }
+
+    for (unsigned i = 1; i < MAX_LEVEL; ++i)
+    {
+        if (next[i] != nullptr)
+            return false;
+    }
+    return true;
+}
+
+template<typename Key, typename Value>
+typename SkipListConcurrent<Key, Value>::Node * SkipListConcurrent<Key, Value>::create_(const Key & k, Value v, unsigned height)
+{
+    void * memory = ::operator new(Node::linksOffset() + height * sizeof(Link));
+    Node * n = new (memory) Node(k, v, height);
+    for (unsigned i = 0; i < height; ++i)
+        new (&n->links()[i]) Link(nullptr);
+    return n;
+}
+
+template<typename Key, typename Value>
+void SkipListConcurrent<Key, Value>::destroy_(Node * n)
+{
+    n->~Node();
+    ::operator delete(n);
+}
+
+template<typename Key, typename Value>
+unsigned SkipListConcurrent<Key, Value>::randomHeight_()
+{
+    thread_local std::minstd_rand generator(std::random_device{}());
+    unsigned bits = static_cast<unsigned>(generator());
+    unsigned height = 1;
+    for (; height < MAX_LEVEL && (bits & 1); bits >>= 1)
+        ++height;
+    return height;
+}
+
+template<typename Key, typename Value>
+void SkipListConcurrent<Key, Value>::findPredecessors_(const Key & k, Link * preds[], Node * succs[])
+{
+    Link * links = head_;
+    for (unsigned i = MAX_LEVEL; i-- > 0; )
+    {
+        Node * n = links[i].load(std::memory_order_acquire);
+        while (n != nullptr && n->key < k)
+        {
+            links = n->links();
+            n = links[i].load(std::memory_order_acquire);
+        }
+        preds[i] = &links[i];
+        succs[i] = n;
+    }
+}
+
+template<typename Key, typename Value>
+const typename SkipListConcurrent<Key, Value>::Node * SkipListConcurrent<Key, Value>::findLast_(const Key & k, bool inclusive) const
+{
+    const Node * last = nullptr;
+    for (unsigned i = MAX_LEVEL; i-- > 0; )
+    {
+        const Node * n = links_(last)[i].load(std::memory_order_acquire);
+        while (n != nullptr && (inclusive ? !(k < n->key) : n->key < k))
+        {
+            last = n;
+            n = n->links()[i].load(std::memory_order_acquire);
+        }
+    }
+    return last;
+}
+
+template<typename Key, typename Value>
+const typename SkipListConcurrent<Key, Value>::Node * SkipListConcurrent<Key, Value>::findEqual_(const Key & k) const
+{
+    const Node * n = links_(findLast_(k, false))[0].load(std::memory_order_acquire);
+    return n != nullptr && !(k < n->key) ? n : nullptr;
+}
+
+} // namespace bst
+
+//--------------------------------------------------------------------------------------------------
+#endif // SKIP_LIST_CONCURRENT_HPP
+//--------------------------------------------------------------------------------------------------
@@ -10,22 +10,132 @@
 
 // -------------------------------------------------------------------------------------------------
 #include "Tools.hpp"
+#include "TaskPool.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
 // -------------------------------------------------------------------------------------------------
 
 namespace sort
 {
 
+/**
+ * @struct Identity
+ * @brief The Identity struct is the default projection, it returns the element itself.
+ */
+struct Identity
+{
+    template<typename T>
+    const T & operator()(const T & value) const { return value; }
+};
+
 /**
  * @brief The less template function is a comparator.
- * @tparam type of elements to compare
+ * @tparam T type of elements to compare
+ * @tparam Compare comparator of the keys, default constructible function object
+ * @tparam Projection function object which maps the element to its key
  * @param[in] a first element
  * @param[in] b second element
- * @return true if a less than b.
+ * @return true if key of a less than key of b.
+ *
+ * Every comparison sort takes Compare and Projection as its template arguments and compares
+ * elements only through this function. They are stateless and are called inline, so default
+ * arguments cost the same as operator<. Comparators with state (lambdas, a column or direction
+ * chosen at run time) are used through BoundSort.
  */
-template<typename T>
+template<typename T, typename Compare = std::less<>, typename Projection = Identity>
 inline bool less(const T & a, const T & b)
 {
-    return std::less<T>()(a, b);
+    return Compare()(Projection()(a), Projection()(b));
+}
+
+/**
+ * @brief The merge template function moves two sorted ranges into the output in sorted order,
+ * elements of the first range go before equal elements of the second one.
+ * @param[in] first begin of the first range
+ * @param[in] mid end of the first range and begin of the second one
+ * @param[in] last end of the second range
+ * @param[out] out begin of the output, should not overlap the ranges
+ * @return end of the output
+ */
+template<typename T, typename Compare = std::less<>, typename Projection = Identity>
+inline T * merge(T * first, T * mid, T * last, T * out)
+{
+    T * i = first;
+    T * j = mid;
+    while (i < mid && j < last)
+    {
+        *out++ = less<T, Compare, Projection>(*j, *i) ? std::move(*j++) : std::move(*i++);
+    }
+    out = std::move(i, mid, out);
+    return std::move(j, last, out);
+}
+
+/**
+ * @struct IsContiguous
+ * @brief The IsContiguous template struct defines whether elements of the iterator range lie in
+ * one array, so the range can be sorted through the pointer to its first element.
+ * @tparam RandomIt random access iterator
+ */
+template<typename RandomIt>
+struct IsContiguous
+{
+    using Value = typename std::iterator_traits<RandomIt>::value_type;
+    enum : bool
+    {
+        value = std::is_pointer<RandomIt>::value
+             || (!std::is_same<Value, bool>::value
+                 && std::is_same<RandomIt, typename std::vector<Value>::iterator>::value)
+    };
+};
+
+/**
+ * @brief The applyRange template function calls the function with the pointer and the length of
+ * the range of random access iterators.
+ * @param[in] first iterator to the first element
+ * @param[in] last iterator past the last element
+ * @param[in] f function called as f(pointer, length) for non-empty range
+ *
+ * Contiguous ranges are passed in place, others (e.g. std::deque) are moved to the buffer and
+ * moved back after the call.
+ */
+template<typename RandomIt, typename Function>
+inline typename std::enable_if<IsContiguous<RandomIt>::value>::type applyRange(RandomIt first, RandomIt last, Function f)
+{
+    if (first != last)
+    {
+        f(&*first, static_cast<size_t>(last - first));
+    }
+}
+
+template<typename RandomIt, typename Function>
+inline typename std::enable_if<!IsContiguous<RandomIt>::value>::type applyRange(RandomIt first, RandomIt last, Function f)
+{
+    using Value = typename std::iterator_traits<RandomIt>::value_type;
+    std::vector<Value> buffer(std::make_move_iterator(first), std::make_move_iterator(last));
+    if (!buffer.empty())
+    {
+        f(buffer.data(), buffer.size());
+    }
+    std::move(buffer.begin(), buffer.end(), first);
+}
+
+/**
+ * @brief The sortRange template function sorts the range of random access iterators by the
+ * pointer and length overload of the sort algorithm.
+ * @tparam Sorter sort algorithm class
+ * @param[in] first iterator to the first element
+ * @param[in] last iterator past the last element
+ */
+template<typename Sorter, typename RandomIt>
+inline void sortRange(RandomIt first, RandomIt last)
+{
+    using Value = typename std::iterator_traits<RandomIt>::value_type;
+    applyRange(first, last, [](Value * array, size_t length) { Sorter::sort(array, length); });
 }
 
 
@@ -37,7 +147,7 @@ inline bool less(const T & a, const T & b)
  * @class DummySort
  * @brief The DummySort template class is the simpliest sort algorithm. Complexity: O(n*n).
  */
-template <typename T>
+template <typename T, typename Compare = std::less<>, typename Projection = Identity>
 class DummySort
 {
 public:
@@ -45,7 +155,22 @@ public:
      * @brief Sorts elements in the container.
      * @param[in] elements container with the elements
      */
-    static void sort(std::vector<T> & elements);
+    static void sort(std::vector<T> & elements) { sort(elements.data(), elements.size()); }
+
+    /**
+     * @brief Sorts elements in the array.
+     * @param[in] array pointer to the first element
+     * @param[in] length count of the elements
+     */
+    static void sort(T * array, size_t length);
+
+    /**
+     * @brief Sorts elements in the range of random access iterators.
+     * @param[in] first iterator to the first element
+     * @param[in] last iterator past the last element
+     */
+    template <typename RandomIt>
+    static void sort(RandomIt first, RandomIt last) { sortRange<DummySort>(first, last); }
 
     /// class name
     static char const * name;
@@ -56,7 +181,7 @@ public:
  * @class BubleSort
  * @brief The BubleSort template class is the classic sort algorithm. Complexity: O(n*n).
  */
-template <typename T>
+template <typename T, typename Compare = std::less<>, typename Projection = Identity>
 class BubleSort
 {
 public:
@@ -64,7 +189,22 @@ public:
      * @brief Sorts elements in the container.
      * @param[in] elements container with the elements
      */
-    static void sort(std::vector<T> & elements);
+    static void sort(std::vector<T> & elements) { sort(elements.data(), elements.size()); }
+
+    /**
+     * @brief Sorts elements in the array.
+     * @param[in] array pointer to the first element
+     * @param[in] length count of the elements
+     */
+    static void sort(T * array, size_t length);
+
+    /**
+     * @brief Sorts elements in the range of random access iterators.
+     * @param[in] first iterator to the first element
+     * @param[in] last iterator past the last element
+     */
+    template <typename RandomIt>
+    static void sort(RandomIt first, RandomIt last) { sortRange<BubleSort>(first, last); }
 
     /// class name
     static char const * name;
@@ -75,7 +215,7 @@ public:
  * @class CombSort
  * @brief The CombSort template class. Complexity: average O(n*log(n)), worst O(n*n).
  */
-template <typename T>
+template <typename T, typename Compare = std::less<>, typename Projection = Identity>
 class CombSort
 {
 public:
@@ -83,7 +223,22 @@ public:
      * @brief Sorts elements in the container.
      * @param[in] elements container with the elements
      */
-    static void sort(std::vector<T> & elements);
+    static void sort(std::vector<T> & elements) { sort(elements.data(), elements.size()); }
+
+    /**
+     * @brief Sorts elements in the array.
+     * @param[in] array pointer to the first element
+     * @param[in] length count of the elements
+     */
+    static void sort(T * array, size_t length);
+
+    /**
+     * @brief Sorts elements in the range of random access iterators.
+     * @param[in] first iterator to the first element
+     * @param[in] last iterator past the last element
+     */
+    template <typename RandomIt>
+    static void sort(RandomIt first, RandomIt last) { sortRange<CombSort>(first, last); }
 
     /// class name
     static char const * name;
@@ -94,7 +249,7 @@ public:
  * @class ShakeSort
  * @brief The ShakeSort template class. Complexity: O(n*n).
  */
-template <typename T>
+template <typename T, typename Compare = std::less<>, typename Projection = Identity>
 class ShakeSort
 {
 public:
@@ -102,7 +257,22 @@ public:
      * @brief Sorts elements in the container.
      * @param[in] elements container with the elements
      */
-    static void sort(std::vector<T> & elements);
+    static void sort(std::vector<T> & elements) { sort(elements.data(), elements.size()); }
+
+    /**
+     * @brief Sorts elements in the array.
+     * @param[in] array pointer to the first element
+     * @param[in] length count of the elements
+     */
+    static void sort(T * array, size_t length);
+
+    /**
+     * @brief Sorts elements in the range of random access iterators.
+     * @param[in] first iterator to the first element
+     * @param[in] last iterator past the last element
+     */
+    template <typename RandomIt>
+    static void sort(RandomIt first, RandomIt last) { sortRange<ShakeSort>(first, last); }
 
     /// class name
     static char const * name;
@@ -113,7 +283,7 @@ public:
  * @class QuickSort
  * @brief The QuickSort template class. Complexity: average O(n*log(n)), worst O(n*n).
  */
-template <typename T>
+template <typename T, typename Compare = std::less<>, typename Projection = Identity>
 class QuickSort
 {
 public:
@@ -121,33 +291,46 @@ public:
      * @brief Sorts elements in the container.
      * @param[in] elements container with the elements
      */
-    static void sort(std::vector<T> & elements)
-    {
-        sort(elements, 0, static_cast<int>(elements.size()) - 1);
-    }
+    static void sort(std::vector<T> & elements) { sort(elements.data(), elements.size()); }
 
-    /// class name
-    static char const * name;
-private:
     /**
-     * @brief Sorts elements in the container.
-     * @param[in] elements container with the elements
+     * @brief Sorts elements in the array.
+     * @param[in] array pointer to the first element
+     * @param[in] length count of the elements
+     */
+    static void sort(T * array, size_t length) { sort(array, 0, static_cast<std::ptrdiff_t>(length) - 1); }
+
+    /**
+     * @brief Sorts elements in the range of random access iterators.
+     * @param[in] first iterator to the first element
+     * @param[in] last iterator past the last element
+     */
+    template <typename RandomIt>
+    static void sort(RandomIt first, RandomIt last) { sortRange<QuickSort>(first, last); }
+
+    /**
+     * @brief Partitions elements of the range around the first one, it is used by the selection
+     * algorithms too.
+     * @param[in] elements array with the elements
      * @param[in] lo left boundary
      * @param[in] hi right boundary
-     *
-     * @note bounders lo and hi should be signed type
+     * @return final position of the pivot, elements before it are not greater and elements after
+     * it are not less
      */
-    static void sort(std::vector<T> & elements, int lo, int hi);
+    static std::ptrdiff_t partition(T * elements, std::ptrdiff_t lo, std::ptrdiff_t hi);
 
+    /// class name
+    static char const * name;
+private:
     /**
-     * @brief Sorts elements in the container.
-     * @param[in] elements container with the elements
+     * @brief Sorts elements in the range.
+     * @param[in] elements array with the elements
      * @param[in] lo left boundary
      * @param[in] hi right boundary
      *
      * @note bounders lo and hi should be signed type
      */
-    static int partition(std::vector<T> & elements, int lo, int hi);
+    static void sort(T * elements, std::ptrdiff_t lo, std::ptrdiff_t hi);
 };
 
 
@@ -156,7 +339,7 @@ private:
  * @brief The QuickSortM template class implements quick-sort-median algorithm.
  * Complexity: average O(n*log(n)), worst O(n*n).
  */
-template <typename T>
+template <typename T, typename Compare = std::less<>, typename Projection = Identity>
 class QuickSortM
 {
 public:
@@ -164,33 +347,45 @@ public:
      * @brief Sorts elements in the container.
      * @param[in] elements container with the elements
      */
-    static void sort(std::vector<T> & elements)
-    {
-        sort(elements, 0, static_cast<int>(elements.size()) - 1);
-    }
+    static void sort(std::vector<T> & elements) { sort(elements.data(), elements.size()); }
+
+    /**
+     * @brief Sorts elements in the array.
+     * @param[in] array pointer to the first element
+     * @param[in] length count of the elements
+     */
+    static void sort(T * array, size_t length) { sort(array, 0, static_cast<std::ptrdiff_t>(length) - 1); }
+
+    /**
+     * @brief Sorts elements in the range of random access iterators.
+     * @param[in] first iterator to the first element
+     * @param[in] last iterator past the last element
+     */
+    template <typename RandomIt>
+    static void sort(RandomIt first, RandomIt last) { sortRange<QuickSortM>(first, last); }
 
     /// class name
     static char const * name;
 private:
     /**
-     * @brief Sorts elements in the container.
-     * @param[in] elements container with the elements
+     * @brief Sorts elements in the range.
+     * @param[in] elements array with the elements
      * @param[in] lo left boundary
      * @param[in] hi right boundary
      *
      * @note bounders lo and hi should be signed type
      */
-    static void sort(std::vector<T> & elements, int lo, int hi);
+    static void sort(T * elements, std::ptrdiff_t lo, std::ptrdiff_t hi);
 
     /**
-     * @brief Sorts elements in the container.
-     * @param[in] elements container with the elements
+     * @brief Sorts elements in the range.
+     * @param[in] elements array with the elements
      * @param[in] lo left boundary
      * @param[in] hi right boundary
      *
      * @note bounders lo and hi should be signed type
      */
-    static int partition(std::vector<T> & elements, int lo, int hi);
+    static std::ptrdiff_t partition(T * elements, std::ptrdiff_t lo, std::ptrdiff_t hi);
 };
 
 
@@ -199,7 +394,7 @@ private:
  * @brief The Quick3Sort template class implements quick-sort-3parts algorithm.
  * Complexity: average O(n*log(n)), worst O(n*n).
  */
-template <typename T>
+template <typename T, typename Compare = std::less<>, typename Projection = Identity>
 class Quick3Sort
 {
 public:
@@ -207,23 +402,46 @@ public:
      * @brief Sorts elements in the container.
      * @param[in] elements container with the elements
      */
-    static void sort(std::vector<T> & elements)
-    {
-        sort(elements, 0, static_cast<int>(elements.size()) - 1);
-    }
+    static void sort(std::vector<T> & elements) { sort(elements.data(), elements.size()); }
+
+    /**
+     * @brief Sorts elements in the array.
+     * @param[in] array pointer to the first element
+     * @param[in] length count of the elements
+     */
+    static void sort(T * array, size_t length) { sort(array, 0, static_cast<std::ptrdiff_t>(length) - 1); }
+
+    /**
+     * @brief Sorts elements in the range of random access iterators.
+     * @param[in] first iterator to the first element
+     * @param[in] last iterator past the last element
+     */
+    template <typename RandomIt>
+    static void sort(RandomIt first, RandomIt last) { sortRange<Quick3Sort>(first, last); }
+
+    /**
+     * @brief Partitions elements of the range into three parts: less than, equal to and greater
+     * than the first one, it is used by the selection algorithms too.
+     * @param[in] elements array with the elements
+     * @param[in] lo left boundary
+     * @param[in] hi right boundary
+     * @param[out] lt first position of the elements equal to the pivot
+     * @param[out] gt last position of the elements equal to the pivot
+     */
+    static void partition(T * elements, std::ptrdiff_t lo, std::ptrdiff_t hi, std::ptrdiff_t & lt, std::ptrdiff_t & gt);
 
     /// class name
     static char const * name;
 private:
     /**
-     * @brief Sorts elements in the container.
-     * @param[in] elements container with the elements
+     * @brief Sorts elements in the range.
+     * @param[in] elements array with the elements
      * @param[in] lo left boundary
      * @param[in] hi right boundary
      *
      * @note bounders lo and hi should be signed type
      */
-    static void sort(std::vector<T> & elements, int lo, int hi);
+    static void sort(T * elements, std::ptrdiff_t lo, std::ptrdiff_t hi);
 };
 
 
@@ -231,7 +449,7 @@ private:
  * @class GnomeSort
  * @brief The GnomeSort template class. Complexity: O(n*n).
  */
-template <typename T>
+template <typename T, typename Compare = std::less<>, typename Projection = Identity>
 class GnomeSort
 {
 public:
@@ -239,7 +457,22 @@ public:
      * @brief Sorts elements in the container.
      * @param[in] elements container with the elements
      */
-    static void sort(std::vector<T> & elements);
+    static void sort(std::vector<T> & elements) { sort(elements.data(), elements.size()); }
+
+    /**
+     * @brief Sorts elements in the array.
+     * @param[in] array pointer to the first element
+     * @param[in] length count of the elements
+     */
+    static void sort(T * array, size_t length);
+
+    /**
+     * @brief Sorts elements in the range of random access iterators.
+     * @param[in] first iterator to the first element
+     * @param[in] last iterator past the last element
+     */
+    template <typename RandomIt>
+    static void sort(RandomIt first, RandomIt last) { sortRange<GnomeSort>(first, last); }
 
     /// class name
     static char const * name;
@@ -255,7 +488,7 @@ public:
  * @class SelectionSort
  * @brief The SelectionSort template class. Complexity: O(n*n).
  */
-template <typename T>
+template <typename T, typename Compare = std::less<>, typename Projection = Identity>
 class SelectionSort
 {
 public:
@@ -263,7 +496,22 @@ public:
      * @brief Sorts elements in the container.
      * @param[in] elements container with the elements
      */
-    static void sort(std::vector<T> & elements);
+    static void sort(std::vector<T> & elements) { sort(elements.data(), elements.size()); }
+
+    /**
+     * @brief Sorts elements in the array.
+     * @param[in] array pointer to the first element
+     * @param[in] length count of the elements
+     */
+    static void sort(T * array, size_t length);
+
+    /**
+     * @brief Sorts elements in the range of random access iterators.
+     * @param[in] first iterator to the first element
+     * @param[in] last iterator past the last element
+     */
+    template <typename RandomIt>
+    static void sort(RandomIt first, RandomIt last) { sortRange<SelectionSort>(first, last); }
 
     /// class name
     static char const * name;
@@ -274,7 +522,7 @@ public:
  * @class HeapSort
  * @brief The HeapSort template class. Complexity: O(n*log(n)).
  */
-template <typename T>
+template <typename T, typename Compare = std::less<>, typename Projection = Identity>
 class HeapSort
 {
 public:
@@ -282,12 +530,27 @@ public:
      * @brief Sorts elements in the container.
      * @param[in] elements container with the elements
      */
-    static void sort(std::vector<T> & elements);
+    static void sort(std::vector<T> & elements) { sort(elements.data(), elements.size()); }
+
+    /**
+     * @brief Sorts elements in the array.
+     * @param[in] array pointer to the first element
+     * @param[in] length count of the elements
+     */
+    static void sort(T * array, size_t length);
+
+    /**
+     * @brief Sorts elements in the range of random access iterators.
+     * @param[in] first iterator to the first element
+     * @param[in] last iterator past the last element
+     */
+    template <typename RandomIt>
+    static void sort(RandomIt first, RandomIt last) { sortRange<HeapSort>(first, last); }
 
     /// class name
     static char const * name;
 private:
-    static void sink(std::vector<T> & elements, int pos, int length);
+    static void sink(T * array, size_t pos, size_t length);
 };
 
 
@@ -299,7 +562,7 @@ private:
  * @class InsertionSort
  * @brief The InsertionSort template class. Complexity: O(n*n).
  */
-template <typename T>
+template <typename T, typename Compare = std::less<>, typename Projection = Identity>
 class InsertionSort
 {
 public:
@@ -307,23 +570,81 @@ public:
      * @brief Sorts elements in the container.
      * @param[in] elements container with the elements
      */
-    static void sort(std::vector<T> & elements);
+    static void sort(std::vector<T> & elements) { sort(elements.data(), elements.size()); }
+
+    /**
+     * @brief Sorts elements in the array.
+     * @param[in] array pointer to the first element
+     * @param[in] length count of the elements
+     */
+    static void sort(T * array, size_t length);
+
     /**
-     * @brief Sorts elements in the container.
-     * @param[in] array container with the elements
-     * @param[in] length length of the array
+     * @brief Sorts elements in the range of random access iterators.
+     * @param[in] first iterator to the first element
+     * @param[in] last iterator past the last element
      */
-    static void sort(T * array, int length);
+    template <typename RandomIt>
+    static void sort(RandomIt first, RandomIt last) { sortRange<InsertionSort>(first, last); }
+
     /// class name
     static char const * name;
 };
 
 
+/**
+ * @class SortingNetwork
+ * @brief The SortingNetwork template class sorts small arrays by the fixed network of
+ * compare-exchange operations. Complexity: O(1) for up to SIZE elements.
+ *
+ * Elements of arithmetic types are copied into the block of SIZE elements padded by the greatest
+ * value and sorted by the Batcher odd-even merge network. Compare-exchange has no branches, it
+ * is compiled into min/max or conditional moves, and the sequence of operations does not depend
+ * on the data, so there are no branch mispredictions on random keys. Other types and custom
+ * comparators or projections are sorted by insertion.
+ */
+template <typename T, typename Compare = std::less<>, typename Projection = Identity>
+class SortingNetwork
+{
+public:
+    /// max count of elements sorted by the network
+    enum : size_t { SIZE = 16 };
+
+    /**
+     * @brief Sorts elements in the array.
+     * @param[in] array pointer to the first element
+     * @param[in] length count of the elements, not greater than SIZE
+     */
+    static void sort(T * array, size_t length)
+    {
+        sort(array, length, std::integral_constant<bool, std::is_arithmetic<T>::value
+                                                        && std::is_same<Compare, std::less<>>::value
+                                                        && std::is_same<Projection, Identity>::value>{});
+    }
+
+private:
+    static void sort(T * array, size_t length, std::true_type);
+    static void sort(T * array, size_t length, std::false_type)
+    {
+        InsertionSort<T, Compare, Projection>{}.sort(array, length);
+    }
+
+    static void compareExchange(T & a, T & b)
+    {
+        bool swap = less<T, Compare, Projection>(b, a);
+        T lo = swap ? b : a;
+        T hi = swap ? a : b;
+        a = lo;
+        b = hi;
+    }
+};
+
+
 /**
  * @class ShellSort
  * @brief The ShellSort template class. Complexity: O(n*log(n)*log(n)).
  */
-template <typename T>
+template <typename T, typename Compare = std::less<>, typename Projection = Identity>
 class ShellSort
 {
 public:
@@ -331,7 +652,22 @@ public:
      * @brief Sorts elements in the container.
      * @param[in] elements container with the elements
      */
-    static void sort(std::vector<T> & elements);
+    static void sort(std::vector<T> & elements) { sort(elements.data(), elements.size()); }
+
+    /**
+     * @brief Sorts elements in the array.
+     * @param[in] array pointer to the first element
+     * @param[in] length count of the elements
+     */
+    static void sort(T * array, size_t length);
+
+    /**
+     * @brief Sorts elements in the range of random access iterators.
+     * @param[in] first iterator to the first element
+     * @param[in] last iterator past the last element
+     */
+    template <typename RandomIt>
+    static void sort(RandomIt first, RandomIt last) { sortRange<ShellSort>(first, last); }
 
     /// class name
     static char const * name;
@@ -346,8 +682,11 @@ public:
 /**
  * @class MergeSort
  * @brief The MergeSort template class. Complexity: O(n*log(n)).
+ *
+ * Levels of the recursion merge elements alternately into the scratch buffer and back, so every
+ * level moves each element once. Scratch buffer may be passed by caller to reuse its memory.
  */
-template <typename T>
+template <typename T, typename Compare = std::less<>, typename Projection = Identity>
 class MergeSort
 {
 public:
@@ -355,35 +694,68 @@ public:
      * @brief Sorts elements in the container.
      * @param[in] elements container with the elements
      */
-    static void sort(std::vector<T> & elements)
+    static void sort(std::vector<T> & elements) { sort(elements.data(), elements.size()); }
+
+    /**
+     * @brief Sorts elements in the container using the scratch buffer.
+     * @param[in] elements container with the elements
+     * @param[in] buffer scratch buffer, it is enlarged to the size of elements if it is smaller
+     */
+    static void sort(std::vector<T> & elements, std::vector<T> & buffer)
+    {
+        sort(elements.data(), elements.size(), buffer);
+    }
+
+    /**
+     * @brief Sorts elements in the array.
+     * @param[in] array pointer to the first element
+     * @param[in] length count of the elements
+     */
+    static void sort(T * array, size_t length)
     {
-        std::vector<T> aux(elements.size());
-        sort(elements, 0, static_cast<int>(elements.size()) - 1, aux);
+        std::vector<T> buffer;
+        sort(array, length, buffer);
     }
 
+    /**
+     * @brief Sorts elements in the array using the scratch buffer.
+     * @param[in] array pointer to the first element
+     * @param[in] length count of the elements
+     * @param[in] buffer scratch buffer, it is enlarged to the length if it is smaller
+     */
+    static void sort(T * array, size_t length, std::vector<T> & buffer);
+
+    /**
+     * @brief Sorts elements in the range of random access iterators.
+     * @param[in] first iterator to the first element
+     * @param[in] last iterator past the last element
+     */
+    template <typename RandomIt>
+    static void sort(RandomIt first, RandomIt last) { sortRange<MergeSort>(first, last); }
+
     /// class name
     static char const * name;
 private:
     /**
-     * @brief Sorts elements in the container and copies its into aux.
-     * @param[in] elements container with the elements
+     * @brief Sorts elements in the range and puts them into elements or into aux.
+     * @param[in] elements array with the elements
+     * @param[in] aux scratch array
      * @param[in] lo left boundary
-     * @param[in] hi right boundary
-     * @param[out] aux container
-     *
-     * @note bounders lo and hi should be signed type
+     * @param[in] hi right boundary, not included
+     * @param[in] toAux whether sorted elements should be put into aux
      */
-    static void sort(std::vector<T> & elements, int lo, int hi, std::vector<T> & aux);
-
-    static void merge(std::vector<T> & elements, int lo, int mid, int hi, std::vector<T> & aux);
+    static void sort(T * elements, T * aux, size_t lo, size_t hi, bool toAux);
 };
 
 
 /**
  * @class MergeUpSort
  * @brief The MergeUpSort template class. Complexity: O(n*log(n)).
+ *
+ * Passes merge elements alternately into the scratch buffer and back, elements are moved back
+ * after the odd count of passes.
  */
-template <typename T>
+template <typename T, typename Compare = std::less<>, typename Projection = Identity>
 class MergeUpSort
 {
 public:
@@ -391,20 +763,122 @@ public:
      * @brief Sorts elements in the container.
      * @param[in] elements container with the elements
      */
-    static void sort(std::vector<T> & elements)
+    static void sort(std::vector<T> & elements) { sort(elements.data(), elements.size()); }
+
+    /**
+     * @brief Sorts elements in the container using the scratch buffer.
+     * @param[in] elements container with the elements
+     * @param[in] buffer scratch buffer, it is enlarged to the size of elements if it is smaller
+     */
+    static void sort(std::vector<T> & elements, std::vector<T> & buffer)
+    {
+        sort(elements.data(), elements.size(), buffer);
+    }
+
+    /**
+     * @brief Sorts elements in the array.
+     * @param[in] array pointer to the first element
+     * @param[in] length count of the elements
+     */
+    static void sort(T * array, size_t length)
     {
-        std::vector<T> aux(elements.size());
-        sort(elements, static_cast<int>(elements.size()), aux);
+        std::vector<T> buffer;
+        sort(array, length, buffer);
     }
 
+    /**
+     * @brief Sorts elements in the array using the scratch buffer.
+     * @param[in] array pointer to the first element
+     * @param[in] length count of the elements
+     * @param[in] buffer scratch buffer, it is enlarged to the length if it is smaller
+     */
+    static void sort(T * array, size_t length, std::vector<T> & buffer);
+
+    /**
+     * @brief Sorts elements in the range of random access iterators.
+     * @param[in] first iterator to the first element
+     * @param[in] last iterator past the last element
+     */
+    template <typename RandomIt>
+    static void sort(RandomIt first, RandomIt last) { sortRange<MergeUpSort>(first, last); }
+
+    /// class name
+    static char const * name;
+};
+
+
+/**
+ * @class PowerSort
+ * @brief The PowerSort template class is the stable natural merge sort which merges presorted
+ * runs of the elements. Complexity: O(n*log(n)), O(n) for concatenation of few sorted runs.
+ *
+ * Ascending and strictly descending runs are found in one pass, descending runs are reversed and
+ * short runs are extended by insertion. Adjacent runs are merged by the powersort policy: the
+ * power of the boundary between two runs is the depth of the node in the perfectly balanced merge
+ * tree, runs on the stack with the greater power are merged first. Merge copies only the smaller
+ * run into the scratch buffer and switches to the exponential search when one run wins several
+ * times in a row.
+ */
+template <typename T, typename Compare = std::less<>, typename Projection = Identity>
+class PowerSort
+{
+public:
+    /**
+     * @brief Sorts elements in the container.
+     * @param[in] elements container with the elements
+     */
+    static void sort(std::vector<T> & elements) { sort(elements.data(), elements.size()); }
+
+    /**
+     * @brief Sorts elements in the array.
+     * @param[in] array pointer to the first element
+     * @param[in] length count of the elements
+     */
+    static void sort(T * array, size_t length);
+
+    /**
+     * @brief Sorts elements in the range of random access iterators.
+     * @param[in] first iterator to the first element
+     * @param[in] last iterator past the last element
+     */
+    template <typename RandomIt>
+    static void sort(RandomIt first, RandomIt last) { sortRange<PowerSort>(first, last); }
+
     /// class name
     static char const * name;
 private:
-    // NOTE: bounders lo and hi should be signed type
-    static void sort(std::vector<T> & elements, int length, std::vector<T> & aux);
+    enum : size_t
+    {
+        MIN_RUN = 32,       // shorter runs are extended by insertion
+        MIN_GALLOP = 7      // wins in a row which start the exponential search
+    };
+
+    /// @brief The Run struct is the sorted part of the elements waiting to be merged.
+    struct Run
+    {
+        size_t start;
+        size_t length;
+        unsigned power;     // power of the boundary with the previous run
+    };
+
+    /// @brief Finds the run which starts at first, makes it ascending and at least MIN_RUN long.
+    static size_t nextRun(T * first, T * last);
+
+    /// @brief Power of the boundary between adjacent runs a and b of n elements.
+    static unsigned power(const Run & a, const Run & b, size_t n);
+
+    /// @brief Merges adjacent sorted parts [first, mid) and [mid, last).
+    static void merge(T * first, T * mid, T * last, std::vector<T> & buffer);
+
+    static void mergeLo(T * first, T * mid, T * last, std::vector<T> & buffer);
+    static void mergeHi(T * first, T * mid, T * last, std::vector<T> & buffer);
 
-    // merge function is the same as in the merge sort algorithm
-    static void merge(std::vector<T> & elements, int lo, int mid, int hi, std::vector<T> & aux);
+    /**
+     * @brief Returns the first element for which pred is false, pred must be true for the
+     * prefix of the range only. The exponential search starts from the given end of the range.
+     */
+    template <typename Pred>
+    static T * gallop(T * first, T * last, Pred pred, bool fromRight);
 };
 
 
@@ -417,8 +891,10 @@ private:
 /**
  * @class QuickInsSort
  * @brief The QuickInsSort template class. Complexity: average O(n*log(n)), worst O(n*n).
+ *
+ * Ranges of up to SortingNetwork::SIZE elements are sorted by SortingNetwork.
  */
-template <typename T>
+template <typename T, typename Compare = std::less<>, typename Projection = Identity>
 class QuickInsSort
 {
 public:
@@ -426,46 +902,171 @@ public:
      * @brief Sorts elements in the container.
      * @param[in] elements container with the elements
      */
-    static void sort(std::vector<T> & elements)
-    {
-        sort(elements, 0, static_cast<int>(elements.size()) - 1);
-    }
+    static void sort(std::vector<T> & elements) { sort(elements.data(), elements.size()); }
+
+    /**
+     * @brief Sorts elements in the array.
+     * @param[in] array pointer to the first element
+     * @param[in] length count of the elements
+     */
+    static void sort(T * array, size_t length) { sort(array, 0, static_cast<std::ptrdiff_t>(length) - 1); }
+
+    /**
+     * @brief Sorts elements in the range of random access iterators.
+     * @param[in] first iterator to the first element
+     * @param[in] last iterator past the last element
+     */
+    template <typename RandomIt>
+    static void sort(RandomIt first, RandomIt last) { sortRange<QuickInsSort>(first, last); }
 
     /// class name
     static char const * name;
 private:
     // NOTE: bounders lo and hi should be signed type
-    static void sort(std::vector<T> & elements, int lo, int hi);
+    static void sort(T * elements, std::ptrdiff_t lo, std::ptrdiff_t hi);
 
-    static int partition(std::vector<T> & elements, int lo, int hi);
+    static std::ptrdiff_t partition(T * elements, std::ptrdiff_t lo, std::ptrdiff_t hi);
 };
 
 
 /**
- * @class MergeInsSort
- * @brief The MergeInsSort template class. Complexity: O(n*log(n)).
+ * @class PdqSort
+ * @brief The PdqSort template class implements pattern-defeating quick sort.
+ * Complexity: O(n*log(n)), O(n) for sorted and reversed elements.
+ *
+ * Pivot is the median of 3 elements or the ninther for big ranges. Elements are partitioned
+ * by blocks: offsets of misplaced elements are collected without branches and swapped in
+ * pairs. When partition turns out unbalanced some elements are shuffled to break the pattern,
+ * after log(n) such partitions the range is sorted by HeapSort. When partition swapped nothing
+ * the parts are sorted by insertion which gives up after a few moves. Ranges with elements equal
+ * to the pivot of the left neighbour are split into the equal part and the greater part.
  */
-template <typename T>
-class MergeInsSort
+template <typename T, typename Compare = std::less<>, typename Projection = Identity>
+class PdqSort
 {
 public:
     /**
      * @brief Sorts elements in the container.
      * @param[in] elements container with the elements
      */
-    static void sort(std::vector<T> & elements)
-    {
-        std::vector<T> aux(elements.size());
-        sort(elements, 0, static_cast<int>(elements.size()) - 1, aux);
-    }
+    static void sort(std::vector<T> & elements) { sort(elements.data(), elements.size()); }
+
+    /**
+     * @brief Sorts elements in the array.
+     * @param[in] array pointer to the first element
+     * @param[in] length count of the elements
+     */
+    static void sort(T * array, size_t length);
+
+    /**
+     * @brief Sorts elements in the range of random access iterators.
+     * @param[in] first iterator to the first element
+     * @param[in] last iterator past the last element
+     */
+    template <typename RandomIt>
+    static void sort(RandomIt first, RandomIt last) { sortRange<PdqSort>(first, last); }
 
     /// class name
     static char const * name;
 private:
-    // NOTE: bounders lo and hi should be signed type
-    static void sort(std::vector<T> & elements, int lo, int hi, std::vector<T> & aux);
+    enum : size_t
+    {
+        INSERTION_CUTOFF = 24,          // ranges smaller than this are sorted by insertion
+        NINTHER_CUTOFF = 128,           // ranges bigger than this use ninther as pivot
+        PARTIAL_INSERTION_LIMIT = 8,    // moves allowed to partial insertion sort
+        BLOCK_SIZE = 64                 // size of the partition block
+    };
+
+    /**
+     * @brief Sorts elements in the range.
+     * @param[in] first pointer to the first element
+     * @param[in] last pointer past the last element
+     * @param[in] badAllowed count of unbalanced partitions left before HeapSort is used
+     * @param[in] leftmost whether the range has no elements on the left, otherwise the
+     * element before first is not greater than any element of the range
+     */
+    static void sort(T * first, T * last, size_t badAllowed, bool leftmost);
+
+    static void insertionSort(T * first, T * last, bool leftmost);
+
+    /// @brief Sorts by insertion, returns false if it made too many moves and gave up.
+    static bool partialInsertionSort(T * first, T * last);
 
-    static void merge(std::vector<T> & elements, int lo, int mid, int hi, std::vector<T> & aux);
+    /// @brief Puts elements a, b, c into the order.
+    static void sort3(T * a, T * b, T * c);
+
+    /**
+     * @brief Partitions the range by pivot *first, elements equal to pivot go to the right part.
+     * @return pointer to the pivot and whether the range was already partitioned
+     */
+    static std::pair<T *, bool> partitionRight(T * first, T * last);
+
+    /// @brief Partitions the range by pivot *first, elements equal to pivot go to the left part.
+    static T * partitionLeft(T * first, T * last);
+
+    static void swapOffsets(T * first, T * last, const unsigned char * offsetsL, const unsigned char * offsetsR, size_t count, bool useSwaps);
+};
+
+
+/**
+ * @class MergeInsSort
+ * @brief The MergeInsSort template class. Complexity: O(n*log(n)).
+ *
+ * Small ranges are sorted by SortingNetwork, levels above them merge elements alternately into
+ * the scratch buffer and back as in MergeSort.
+ */
+template <typename T, typename Compare = std::less<>, typename Projection = Identity>
+class MergeInsSort
+{
+public:
+    /**
+     * @brief Sorts elements in the container.
+     * @param[in] elements container with the elements
+     */
+    static void sort(std::vector<T> & elements) { sort(elements.data(), elements.size()); }
+
+    /**
+     * @brief Sorts elements in the container using the scratch buffer.
+     * @param[in] elements container with the elements
+     * @param[in] buffer scratch buffer, it is enlarged to the size of elements if it is smaller
+     */
+    static void sort(std::vector<T> & elements, std::vector<T> & buffer)
+    {
+        sort(elements.data(), elements.size(), buffer);
+    }
+
+    /**
+     * @brief Sorts elements in the array.
+     * @param[in] array pointer to the first element
+     * @param[in] length count of the elements
+     */
+    static void sort(T * array, size_t length)
+    {
+        std::vector<T> buffer;
+        sort(array, length, buffer);
+    }
+
+    /**
+     * @brief Sorts elements in the array using the scratch buffer.
+     * @param[in] array pointer to the first element
+     * @param[in] length count of the elements
+     * @param[in] buffer scratch buffer, it is enlarged to the length if it is smaller
+     */
+    static void sort(T * array, size_t length, std::vector<T> & buffer);
+
+    /**
+     * @brief Sorts elements in the range of random access iterators.
+     * @param[in] first iterator to the first element
+     * @param[in] last iterator past the last element
+     */
+    template <typename RandomIt>
+    static void sort(RandomIt first, RandomIt last) { sortRange<MergeInsSort>(first, last); }
+
+    /// class name
+    static char const * name;
+private:
+    // the same as in the merge sort algorithm
+    static void sort(T * elements, T * aux, size_t lo, size_t hi, bool toAux);
 };
 
 
@@ -473,7 +1074,7 @@ private:
  * @class InsertionBinarySort
  * @brief The InsertionBinarySort template class. Complexity: O(n*n).
  */
-template <typename T>
+template <typename T, typename Compare = std::less<>, typename Projection = Identity>
 class InsertionBinarySort
 {
 public:
@@ -481,10 +1082,722 @@ public:
      * @brief Sorts elements in the container.
      * @param[in] elements container with the elements
      */
-    static void sort(std::vector<T> & elements);
+    static void sort(std::vector<T> & elements) { sort(elements.data(), elements.size()); }
+
+    /**
+     * @brief Sorts elements in the array.
+     * @param[in] array pointer to the first element
+     * @param[in] length count of the elements
+     */
+    static void sort(T * array, size_t length);
+
+    /**
+     * @brief Sorts elements in the range of random access iterators.
+     * @param[in] first iterator to the first element
+     * @param[in] last iterator past the last element
+     */
+    template <typename RandomIt>
+    static void sort(RandomIt first, RandomIt last) { sortRange<InsertionBinarySort>(first, last); }
+
+    /// class name
+    static char const * name;
+};
+
+
+// ------------------------------------------------------------------------------------------
+// ---------------- Parallel sort algorithms ------------------------------------------------
+// ------------------------------------------------------------------------------------------
+
+/**
+ * @class ParallelMergeSort
+ * @brief The ParallelMergeSort template class sorts halves in parallel tasks, then merges them
+ * in parallel: output is cut into chunks and the start of every chunk in both halves is found
+ * by binary search (co-ranking). Complexity: O(n*log(n)).
+ *
+ * Halves are merged from the scratch buffer into the elements and vice versa on the next level,
+ * so elements are copied only once on the lowest level.
+ */
+template <typename T, typename Compare = std::less<>, typename Projection = Identity>
+class ParallelMergeSort
+{
+public:
+    /**
+     * @brief Sorts elements in the container using the shared task pool.
+     * @param[in] elements container with the elements
+     */
+    static void sort(std::vector<T> & elements) { sort(elements.data(), elements.size(), tools::TaskPool::instance()); }
+
+    /**
+     * @brief Sorts elements in the container.
+     * @param[in] elements container with the elements
+     * @param[in] pool task pool which runs the parallel parts
+     */
+    static void sort(std::vector<T> & elements, tools::TaskPool & pool) { sort(elements.data(), elements.size(), pool); }
+
+    /**
+     * @brief Sorts elements in the array using the shared task pool.
+     * @param[in] array pointer to the first element
+     * @param[in] length count of the elements
+     */
+    static void sort(T * array, size_t length) { sort(array, length, tools::TaskPool::instance()); }
+
+    /**
+     * @brief Sorts elements in the array.
+     * @param[in] array pointer to the first element
+     * @param[in] length count of the elements
+     * @param[in] pool task pool which runs the parallel parts
+     */
+    static void sort(T * array, size_t length, tools::TaskPool & pool);
+
+    /**
+     * @brief Sorts elements in the range of random access iterators.
+     * @param[in] first iterator to the first element
+     * @param[in] last iterator past the last element
+     */
+    template <typename RandomIt>
+    static void sort(RandomIt first, RandomIt last) { sortRange<ParallelMergeSort>(first, last); }
+
+    /// class name
+    static char const * name;
+private:
+    /// ranges shorter than CUTOFF are processed by one thread
+    enum : size_t { CUTOFF = 1 << 13, INSERTION_CUTOFF = 16 };
+
+    // sorts range of a and puts the result into b if toB is true or into a otherwise
+    static void sort(T * a, T * b, size_t lo, size_t hi, bool toB, tools::TaskPool & pool);
+
+    static void sequentialSort(T * elements, T * aux, size_t lo, size_t hi);
+
+    static void merge(const T * src, T * dst, size_t lo, size_t mid, size_t hi, tools::TaskPool & pool);
+
+    static void merge(const T * a, const T * aEnd, const T * b, const T * bEnd, T * out);
+
+    // count of the left half elements among the first k elements of the merged range
+    static size_t coRank(const T * src, size_t lo, size_t mid, size_t hi, size_t k);
+};
+
+
+/**
+ * @class ParallelQuickSort
+ * @brief The ParallelQuickSort template class implements the parallel sample sort, the quick sort
+ * with many pivots at once. Complexity: O(n*log(n)), O(n) extra memory.
+ *
+ * Splitters are taken from the sorted sample of the elements and cut the value range into
+ * buckets. Blocks of the elements count their elements of every bucket in parallel, then move
+ * them into the scratch buffer in parallel, every block writing to its own part of every bucket.
+ * At last buckets are sorted by PdqSort in parallel and moved back. No pass is sequential, and a
+ * bad sample only makes buckets unequal: every bucket is sorted in O(m*log(m)) time anyway.
+ */
+template <typename T, typename Compare = std::less<>, typename Projection = Identity>
+class ParallelQuickSort
+{
+public:
+    /**
+     * @brief Sorts elements in the container using the shared task pool.
+     * @param[in] elements container with the elements
+     */
+    static void sort(std::vector<T> & elements) { sort(elements.data(), elements.size(), tools::TaskPool::instance()); }
+
+    /**
+     * @brief Sorts elements in the container.
+     * @param[in] elements container with the elements
+     * @param[in] pool task pool which runs the parallel parts
+     */
+    static void sort(std::vector<T> & elements, tools::TaskPool & pool) { sort(elements.data(), elements.size(), pool); }
+
+    /**
+     * @brief Sorts elements in the array using the shared task pool.
+     * @param[in] array pointer to the first element
+     * @param[in] length count of the elements
+     */
+    static void sort(T * array, size_t length) { sort(array, length, tools::TaskPool::instance()); }
+
+    /**
+     * @brief Sorts elements in the array.
+     * @param[in] array pointer to the first element
+     * @param[in] length count of the elements
+     * @param[in] pool task pool which runs the parallel parts
+     */
+    static void sort(T * array, size_t length, tools::TaskPool & pool);
+
+    /**
+     * @brief Sorts elements in the range of random access iterators.
+     * @param[in] first iterator to the first element
+     * @param[in] last iterator past the last element
+     */
+    template <typename RandomIt>
+    static void sort(RandomIt first, RandomIt last) { sortRange<ParallelQuickSort>(first, last); }
 
     /// class name
     static char const * name;
+private:
+    enum : size_t
+    {
+        CUTOFF = 1 << 13,       // min count of elements of one bucket
+        BUCKETS_PER_THREAD = 4, // more buckets than threads balance the load
+        MAX_BUCKETS = 256,      // bucket index of the element fits into one byte
+        OVERSAMPLING = 32       // count of sample elements per bucket
+    };
+
+    /// @brief Runs f(0), ..., f(count - 1) in parallel tasks.
+    template <typename Function>
+    static void parallelFor(size_t count, Function f, tools::TaskPool & pool);
+};
+
+
+// ------------------------------------------------------------------------------------------
+// ---------------- Key extraction sort algorithms ------------------------------------------
+// ------------------------------------------------------------------------------------------
+
+/**
+ * @class KeyedSort
+ * @brief The KeyedSort template class sorts elements by the keys computed once for every element
+ * (Schwartzian transform). Complexity: the complexity of Sorter plus n key computations.
+ * @tparam T type of the element
+ * @tparam KeyFunction default constructible function object which computes the key of element
+ * @tparam Sorter comparison sort of the pairs key-index
+ * @tparam Compare comparator of the keys
+ *
+ * Pairs of the key and the index of element are sorted instead of the elements, then elements
+ * are moved to their places. Equal keys are ordered by the index, so the sort is stable with any
+ * Sorter. It pays off when the key is expensive to compute or elements are expensive to move.
+ */
+template <typename T, typename KeyFunction, template <typename...> class Sorter = PdqSort, typename Compare = std::less<>>
+class KeyedSort
+{
+public:
+    /**
+     * @brief Sorts elements in the container.
+     * @param[in] elements container with the elements
+     */
+    static void sort(std::vector<T> & elements) { sort(elements.data(), elements.size()); }
+
+    /**
+     * @brief Sorts elements in the array.
+     * @param[in] array pointer to the first element
+     * @param[in] length count of the elements
+     */
+    static void sort(T * array, size_t length);
+
+    /**
+     * @brief Sorts elements in the range of random access iterators.
+     * @param[in] first iterator to the first element
+     * @param[in] last iterator past the last element
+     */
+    template <typename RandomIt>
+    static void sort(RandomIt first, RandomIt last) { sortRange<KeyedSort>(first, last); }
+
+    /// class name
+    static char const * name;
+private:
+    using Key = typename std::decay<decltype(KeyFunction()(std::declval<const T &>()))>::type;
+    using Item = std::pair<Key, size_t>;
+
+    /// @brief Compares items by the key, then by the index
+    struct ItemCompare
+    {
+        bool operator()(const Item & a, const Item & b) const
+        {
+            if (Compare()(a.first, b.first))
+                return true;
+            return !Compare()(b.first, a.first) && a.second < b.second;
+        }
+    };
+};
+
+/**
+ * @class BoundSort
+ * @brief The BoundSort template class sorts elements with the comparator and the projection
+ * objects, which may have state and need not be default constructible (e.g. lambdas).
+ * Complexity: the complexity of Sorter plus n moves of elements.
+ * @tparam T type of the element
+ * @tparam Sorter comparison sort of the handles of elements
+ * @tparam Compare comparator of the keys
+ * @tparam Projection function object which maps the element to its key
+ *
+ * Sorters create Compare and Projection for every comparison, so handles are sorted instead of
+ * the elements: pointer to the element and pointer to the BoundSort whose objects compare them.
+ * Then elements are moved to their places. The sort is stable if Sorter is stable. Use bindSort
+ * to deduce the types of the objects.
+ */
+template <typename T, template <typename...> class Sorter = PdqSort, typename Compare = std::less<>, typename Projection = Identity>
+class BoundSort
+{
+public:
+    /**
+     * @brief The BoundSort constructor.
+     * @param[in] compare comparator of the keys
+     * @param[in] projection function object which maps the element to its key
+     */
+    explicit BoundSort(Compare compare = Compare(), Projection projection = Projection())
+        : compare_(std::move(compare)), projection_(std::move(projection))
+    {}
+
+    /**
+     * @brief Sorts elements in the container.
+     * @param[in] elements container with the elements
+     */
+    void sort(std::vector<T> & elements) const { sort(elements.data(), elements.size()); }
+
+    /**
+     * @brief Sorts elements in the array.
+     * @param[in] array pointer to the first element
+     * @param[in] length count of the elements
+     */
+    void sort(T * array, size_t length) const;
+
+    /**
+     * @brief Sorts elements in the range of random access iterators.
+     * @param[in] first iterator to the first element
+     * @param[in] last iterator past the last element
+     */
+    template <typename RandomIt>
+    void sort(RandomIt first, RandomIt last) const
+    {
+        applyRange(first, last, [this](T * array, size_t length) { sort(array, length); });
+    }
+
+    /// class name
+    static char const * name;
+private:
+    /// @brief Element and the sort which compares it
+    struct Handle
+    {
+        T * element;
+        const BoundSort * owner;
+    };
+
+    /// @brief Compares handles by the objects of their sort
+    struct HandleCompare
+    {
+        bool operator()(const Handle & a, const Handle & b) const
+        {
+            return a.owner->compare_(a.owner->projection_(*a.element), a.owner->projection_(*b.element));
+        }
+    };
+
+    Compare compare_;
+    Projection projection_;
+};
+
+/**
+ * @brief The bindSort template function makes BoundSort of the given objects.
+ * @tparam T type of the element
+ * @tparam Sorter comparison sort of the handles of elements
+ * @param[in] compare comparator of the keys
+ * @param[in] projection function object which maps the element to its key
+ * @return BoundSort which sorts with the objects, e.g. bindSort<Row>(byColumn).sort(rows)
+ */
+template <typename T, template <typename...> class Sorter = PdqSort, typename Compare, typename Projection = Identity>
+BoundSort<T, Sorter, Compare, Projection> bindSort(Compare compare, Projection projection = Projection())
+{
+    return BoundSort<T, Sorter, Compare, Projection>(std::move(compare), std::move(projection));
+}
+
+
+// ------------------------------------------------------------------------------------------
+// ---------------- Partial sort and selection algorithms -----------------------------------
+// ------------------------------------------------------------------------------------------
+
+/**
+ * @class QuickSelect
+ * @brief The QuickSelect template class puts the element which would be at the position k of the
+ * sorted sequence to its place, elements before it are not greater and elements after it are not
+ * less (introselect). Complexity: average O(n), worst O(n*log(n)).
+ *
+ * The range is narrowed by the 3-way partition of Quick3Sort around the median of three, so the
+ * search stops as soon as k falls among the keys equal to the pivot. If the range is not narrowed
+ * down in 2*log(n) steps, the rest is sorted by HeapSort. Small ranges are sorted by insertion.
+ */
+template <typename T, typename Compare = std::less<>, typename Projection = Identity>
+class QuickSelect
+{
+public:
+    /**
+     * @brief Puts the element k of the container to its place.
+     * @param[in] elements container with the elements
+     * @param[in] k position of the element, nothing is done if it is out of the container
+     */
+    static void select(std::vector<T> & elements, size_t k) { select(elements.data(), elements.size(), k); }
+
+    /**
+     * @brief Puts the element k of the array to its place.
+     * @param[in] array pointer to the first element
+     * @param[in] length count of the elements
+     * @param[in] k position of the element, nothing is done if it is out of the array
+     */
+    static void select(T * array, size_t length, size_t k);
+
+    /**
+     * @brief Puts the element of the range of random access iterators to its place.
+     * @param[in] first iterator to the first element
+     * @param[in] nth iterator to the position of the element
+     * @param[in] last iterator past the last element
+     */
+    template <typename RandomIt>
+    static void select(RandomIt first, RandomIt nth, RandomIt last)
+    {
+        const size_t k = static_cast<size_t>(nth - first);
+        applyRange(first, last, [k](T * array, size_t length) { select(array, length, k); });
+    }
+
+    /// class name
+    static char const * name;
+private:
+    enum : size_t { INSERTION_CUTOFF = 16 };
+};
+
+
+/**
+ * @class FloydRivestSelect
+ * @brief The FloydRivestSelect template class puts the element which would be at the position k
+ * of the sorted sequence to its place, like QuickSelect does. Complexity: average
+ * n + min(k, n - k) + o(n) comparisons.
+ *
+ * Before the partition of the big range the small sample around k is selected recursively, so
+ * the pivot is very close to the element k and almost all elements of the range are dropped by
+ * one partition of QuickSort. It is faster than QuickSelect on big ranges of distinct keys.
+ */
+template <typename T, typename Compare = std::less<>, typename Projection = Identity>
+class FloydRivestSelect
+{
+public:
+    /**
+     * @brief Puts the element k of the container to its place.
+     * @param[in] elements container with the elements
+     * @param[in] k position of the element, nothing is done if it is out of the container
+     */
+    static void select(std::vector<T> & elements, size_t k) { select(elements.data(), elements.size(), k); }
+
+    /**
+     * @brief Puts the element k of the array to its place.
+     * @param[in] array pointer to the first element
+     * @param[in] length count of the elements
+     * @param[in] k position of the element, nothing is done if it is out of the array
+     */
+    static void select(T * array, size_t length, size_t k)
+    {
+        if (k < length)
+            select(array, 0, static_cast<std::ptrdiff_t>(length) - 1, static_cast<std::ptrdiff_t>(k));
+    }
+
+    /**
+     * @brief Puts the element of the range of random access iterators to its place.
+     * @param[in] first iterator to the first element
+     * @param[in] nth iterator to the position of the element
+     * @param[in] last iterator past the last element
+     */
+    template <typename RandomIt>
+    static void select(RandomIt first, RandomIt nth, RandomIt last)
+    {
+        const size_t k = static_cast<size_t>(nth - first);
+        applyRange(first, last, [k](T * array, size_t length) { select(array, length, k); });
+    }
+
+    /// class name
+    static char const * name;
+private:
+    /// ranges bigger than SAMPLE_CUTOFF are narrowed by the sample first
+    enum : std::ptrdiff_t { SAMPLE_CUTOFF = 600 };
+
+    static void select(T * elements, std::ptrdiff_t left, std::ptrdiff_t right, std::ptrdiff_t k);
+};
+
+
+/**
+ * @class PartialSort
+ * @brief The PartialSort template class puts k least elements in sorted order to the beginning,
+ * the order of the rest is unspecified. Complexity: average O(n + k*log(k)).
+ *
+ * QuickSelect puts the element k - 1 to its place, then the elements before it are sorted by
+ * PdqSort.
+ */
+template <typename T, typename Compare = std::less<>, typename Projection = Identity>
+class PartialSort
+{
+public:
+    /**
+     * @brief Sorts k least elements of the container.
+     * @param[in] elements container with the elements
+     * @param[in] k count of the elements to sort, the whole container is sorted if it is bigger
+     */
+    static void sort(std::vector<T> & elements, size_t k) { sort(elements.data(), elements.size(), k); }
+
+    /**
+     * @brief Sorts k least elements of the array.
+     * @param[in] array pointer to the first element
+     * @param[in] length count of the elements
+     * @param[in] k count of the elements to sort, the whole array is sorted if it is bigger
+     */
+    static void sort(T * array, size_t length, size_t k);
+
+    /**
+     * @brief Sorts the least elements of the range of random access iterators.
+     * @param[in] first iterator to the first element
+     * @param[in] middle iterator past the last element to sort
+     * @param[in] last iterator past the last element
+     */
+    template <typename RandomIt>
+    static void sort(RandomIt first, RandomIt middle, RandomIt last)
+    {
+        const size_t k = static_cast<size_t>(middle - first);
+        applyRange(first, last, [k](T * array, size_t length) { sort(array, length, k); });
+    }
+
+    /// class name
+    static char const * name;
+};
+
+
+/**
+ * @class TopK
+ * @brief The TopK template class keeps k least elements of the stream, e.g. k best scores with
+ * std::greater<> comparator. Complexity: O(log(k)) per element which gets into the top, one
+ * comparison per element which does not.
+ *
+ * Kept elements form the heap with the greatest of them in the root, so the new element is
+ * compared with the root only, unless it is less and replaces the root.
+ */
+template <typename T, typename Compare = std::less<>, typename Projection = Identity>
+class TopK
+{
+public:
+    /**
+     * @brief The TopK constructor.
+     * @param[in] k max count of the kept elements
+     */
+    explicit TopK(size_t k) : k_(k), heap_() {}
+
+    /// @brief Offers the element to the top.
+    void push(const T & value);
+
+    /// @brief Offers elements of the range to the top.
+    template <typename InputIt>
+    void push(InputIt first, InputIt last)
+    {
+        for (; first != last; ++first)
+            push(*first);
+    }
+
+    /// @brief Returns count of the kept elements.
+    size_t size() const { return heap_.size(); }
+
+    /// @brief Defines whether no element is kept.
+    bool empty() const { return heap_.empty(); }
+
+    /// @brief Returns the greatest kept element, the top should not be empty.
+    const T & top() const { return heap_.front(); }
+
+    /// @brief Returns the kept elements in sorted order.
+    std::vector<T> sorted() const;
+
+    /// @brief Removes all kept elements.
+    void clear() { heap_.clear(); }
+
+private:
+    size_t k_;
+    std::vector<T> heap_;
+
+    void siftUp_(size_t pos);
+    void siftDown_(size_t pos);
+};
+
+
+// ------------------------------------------------------------------------------------------
+// ---------------- Radix sort algorithms ---------------------------------------------------
+// ------------------------------------------------------------------------------------------
+
+/**
+ * @struct RadixKey
+ * @brief The RadixKey template struct maps the element to the unsigned key with the same order,
+ * so the radix sorts can compare keys digit by digit.
+ * @tparam T type of the element, integral or floating point
+ */
+template <typename T, typename Enable = void>
+struct RadixKey;
+
+/**
+ * @struct RadixKey
+ * @brief The RadixKey specialization for integers flips the sign bit of signed values, so
+ * negative values go before positive ones.
+ */
+template <typename T>
+struct RadixKey<T, typename std::enable_if<std::is_integral<T>::value>::type>
+{
+    using Type = typename std::make_unsigned<T>::type;
+    static Type get(const T & value)
+    {
+        const Type sign = std::is_signed<T>::value ? static_cast<Type>(Type(1) << (sizeof(T) * 8 - 1)) : Type(0);
+        return static_cast<Type>(static_cast<Type>(value) ^ sign);
+    }
+};
+
+/**
+ * @struct RadixKey
+ * @brief The RadixKey specialization for IEEE floats inverts all bits of negative values and
+ * sets the sign bit of positive ones, so the keys are ordered as the values.
+ */
+template <typename T>
+struct RadixKey<T, typename std::enable_if<std::is_floating_point<T>::value>::type>
+{
+    static_assert(sizeof(T) == 4 || sizeof(T) == 8, "RadixKey: only 32 and 64 bit floats are supported");
+    using Type = typename std::conditional<sizeof(T) == 4, uint32_t, uint64_t>::type;
+    static Type get(const T & value)
+    {
+        Type bits;
+        std::memcpy(&bits, &value, sizeof(T));
+        const Type sign = static_cast<Type>(Type(1) << (sizeof(T) * 8 - 1));
+        return (bits & sign) ? static_cast<Type>(~bits) : static_cast<Type>(bits | sign);
+    }
+};
+
+
+/**
+ * @class LsdRadixSort
+ * @brief The LsdRadixSort template class sorts integers and floats by bytes of their keys
+ * starting from the least significant one. Complexity: O(n*sizeof(T)).
+ *
+ * Every pass is a stable counting sort into the scratch buffer, passes where all keys have the
+ * same byte are skipped. In the parallel mode elements are split into chunks, every chunk
+ * counts its bytes and scatters its elements by its own offsets in a separate task.
+ */
+template <typename T>
+class LsdRadixSort
+{
+public:
+    /**
+     * @brief Sorts elements in the container.
+     * @param[in] elements container with the elements
+     */
+    static void sort(std::vector<T> & elements) { sort(elements.data(), elements.size(), nullptr); }
+
+    /**
+     * @brief Sorts elements in the container, histograms and scattering are done in parallel.
+     * @param[in] elements container with the elements
+     * @param[in] pool task pool which runs the parallel parts
+     */
+    static void sort(std::vector<T> & elements, tools::TaskPool & pool) { sort(elements.data(), elements.size(), &pool); }
+
+    /**
+     * @brief Sorts elements in the array.
+     * @param[in] array pointer to the first element
+     * @param[in] length count of the elements
+     */
+    static void sort(T * array, size_t length) { sort(array, length, nullptr); }
+
+    /**
+     * @brief Sorts elements in the array, histograms and scattering are done in parallel.
+     * @param[in] array pointer to the first element
+     * @param[in] length count of the elements
+     * @param[in] pool task pool which runs the parallel parts
+     */
+    static void sort(T * array, size_t length, tools::TaskPool & pool) { sort(array, length, &pool); }
+
+    /**
+     * @brief Sorts elements in the range of random access iterators.
+     * @param[in] first iterator to the first element
+     * @param[in] last iterator past the last element
+     */
+    template <typename RandomIt>
+    static void sort(RandomIt first, RandomIt last) { sortRange<LsdRadixSort>(first, last); }
+
+    /// class name
+    static char const * name;
+private:
+    /// parallel mode is used for MIN_PARALLEL elements and more
+    enum : size_t { RADIX = 256, MIN_PARALLEL = 1 << 16 };
+
+    static void sort(T * array, size_t length, tools::TaskPool * pool);
+};
+
+
+/**
+ * @class MsdRadixSort
+ * @brief The MsdRadixSort template class sorts strings by their characters starting from the
+ * first one. Complexity: O(n*w), w - average length of the distinguishing prefix.
+ * @tparam T string type
+ */
+template <typename T>
+class MsdRadixSort
+{
+public:
+    /**
+     * @brief Sorts elements in the container.
+     * @param[in] elements container with the elements
+     */
+    static void sort(std::vector<T> & elements) { sort(elements.data(), elements.size()); }
+
+    /**
+     * @brief Sorts elements in the array.
+     * @param[in] array pointer to the first element
+     * @param[in] length count of the elements
+     */
+    static void sort(T * array, size_t length);
+
+    /**
+     * @brief Sorts elements in the range of random access iterators.
+     * @param[in] first iterator to the first element
+     * @param[in] last iterator past the last element
+     */
+    template <typename RandomIt>
+    static void sort(RandomIt first, RandomIt last) { sortRange<MsdRadixSort>(first, last); }
+
+    /// class name
+    static char const * name;
+private:
+    enum : size_t { RADIX = 256, INSERTION_CUTOFF = 16 };
+
+    // sorts range with the same first d characters
+    static void sort(T * elements, std::vector<T> & aux, size_t lo, size_t hi, size_t d);
+
+    static void insertionSort(T * elements, size_t lo, size_t hi, size_t d);
+
+    // character d or -1 if the string is shorter
+    static int charAt(const T & s, size_t d) { return d < s.size() ? static_cast<unsigned char>(s[d]) : -1; }
+};
+
+
+/**
+ * @class AmericanFlagSort
+ * @brief The AmericanFlagSort template class is the in-place radix sort of integers and floats
+ * starting from the most significant byte. Complexity: O(n*sizeof(T)).
+ *
+ * Elements are moved to their byte buckets by cycles of swaps, so no scratch buffer is needed,
+ * then every bucket is sorted by the next byte. Small buckets are sorted by insertion.
+ */
+template <typename T>
+class AmericanFlagSort
+{
+public:
+    /**
+     * @brief Sorts elements in the container.
+     * @param[in] elements container with the elements
+     */
+    static void sort(std::vector<T> & elements) { sort(elements.data(), elements.size()); }
+
+    /**
+     * @brief Sorts elements in the array.
+     * @param[in] array pointer to the first element
+     * @param[in] length count of the elements
+     */
+    static void sort(T * array, size_t length);
+
+    /**
+     * @brief Sorts elements in the range of random access iterators.
+     * @param[in] first iterator to the first element
+     * @param[in] last iterator past the last element
+     */
+    template <typename RandomIt>
+    static void sort(RandomIt first, RandomIt last) { sortRange<AmericanFlagSort>(first, last); }
+
+    /// class name
+    static char const * name;
+private:
+    enum : size_t { RADIX = 256, INSERTION_CUTOFF = 32 };
+
+    static void sort(T * elements, size_t lo, size_t hi, size_t shift);
+
+    static size_t digit(const T & value, size_t shift) { return (RadixKey<T>::get(value) >> shift) & (RADIX - 1); }
 };
 
 } // namespace sort
@@ -10,6 +10,10 @@
 
 //--------------------------------------------------------------------------------------------------
 #include "Sort.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
 //--------------------------------------------------------------------------------------------------
 
 namespace sort
@@ -20,17 +24,19 @@ namespace sort
 // ----- DummySort -----
 //
 
-template <typename T>
-void DummySort<T>::sort(std::vector<T> & elements)
+template <typename T, typename Compare, typename Projection>
+void DummySort<T, Compare, Projection>::sort(T * elements, size_t length)
 {
-    size_t length = elements.size();
+    if (length < 2)
+        return;
+
     bool isSorted = false;
     while (!isSorted)
     {
         isSorted = true;
         for (size_t i = 0; i < length - 1; i++)
         {
-            if (elements[i] != elements[i + 1] && !less(elements[i], elements[i + 1]))
+            if (less<T, Compare, Projection>(elements[i + 1], elements[i]))
             {
                 std::swap(elements[i], elements[i + 1]);
                 isSorted = false;
@@ -39,23 +45,22 @@ void DummySort<T>::sort(std::vector<T> & elements)
     }
 }
 
-template <typename T>
-char const * DummySort<T>::name = "Dummy sort";
+template <typename T, typename Compare, typename Projection>
+char const * DummySort<T, Compare, Projection>::name = "Dummy sort";
 
 
 // -------------------------------------------------------------------------------
 // ----- BubleSort -----
 //
 
-template <typename T>
-void BubleSort<T>::sort(std::vector<T> & elements)
+template <typename T, typename Compare, typename Projection>
+void BubleSort<T, Compare, Projection>::sort(T * elements, size_t length)
 {
-    size_t length = elements.size();
     for (size_t i = 0; i < length; i++)
     {
         for (size_t j = 0; j < length - i - 1; ++j)
         {
-            if (elements[j] != elements[j + 1] && !less(elements[j], elements[j + 1]))
+            if (less<T, Compare, Projection>(elements[j + 1], elements[j]))
             {
                 std::swap(elements[j], elements[j + 1]);
             }
@@ -63,18 +68,17 @@ void BubleSort<T>::sort(std::vector<T> & elements)
     }
 }
 
-template <typename T>
-char const * BubleSort<T>::name = "Buble sort";
+template <typename T, typename Compare, typename Projection>
+char const * BubleSort<T, Compare, Projection>::name = "Buble sort";
 
 
 // -------------------------------------------------------------------------------
 // ----- CombSort -----
 //
 
-template <typename T>
-void CombSort<T>::sort(std::vector<T> & elements)
+template <typename T, typename Compare, typename Projection>
+void CombSort<T, Compare, Projection>::sort(T * elements, size_t length)
 {
-    size_t length = elements.size();
     size_t h = length;
     bool swapped = true;
     while (h > 1 || swapped)
@@ -85,7 +89,7 @@ void CombSort<T>::sort(std::vector<T> & elements)
         swapped = false;
         for (size_t i = 0; i + h < length; i++)
         {
-            if (less(elements[i + h], elements[i]))
+            if (less<T, Compare, Projection>(elements[i + h], elements[i]))
             {
                 std::swap(elements[i], elements[i + h]);
                 swapped = true;
@@ -94,32 +98,31 @@ void CombSort<T>::sort(std::vector<T> & elements)
     }
 }
 
-template <typename T>
-char const * CombSort<T>::name = "Comb sort";
+template <typename T, typename Compare, typename Projection>
+char const * CombSort<T, Compare, Projection>::name = "Comb sort";
 
 
 // -------------------------------------------------------------------------------
 // ----- ShakeSort -----
 //
 
-template <typename T>
-void ShakeSort<T>::sort(std::vector<T> & elements)
+template <typename T, typename Compare, typename Projection>
+void ShakeSort<T, Compare, Projection>::sort(T * elements, size_t length)
 {
-    int length = static_cast<int>(elements.size());
-    for (int left = 0, right = length - 1; left < right;) {
+    for (std::ptrdiff_t left = 0, right = static_cast<std::ptrdiff_t>(length) - 1; left < right;) {
 
-        for (int j = left; j < right; ++j)
+        for (std::ptrdiff_t j = left; j < right; ++j)
         {
-            if (elements[j] != elements[j + 1] && less(elements[j + 1], elements[j]))
+            if (less<T, Compare, Projection>(elements[j + 1], elements[j]))
             {
                 std::swap(elements[j], elements[j + 1]);
             }
         }
         right--;
 
-        for (int j = right; j > left; --j)
+        for (std::ptrdiff_t j = right; j > left; --j)
         {
-            if (elements[j] != elements[j - 1] && less(elements[j], elements[j - 1]))
+            if (less<T, Compare, Projection>(elements[j], elements[j - 1]))
             {
                 std::swap(elements[j - 1], elements[j]);
             }
@@ -128,40 +131,40 @@ void ShakeSort<T>::sort(std::vector<T> & elements)
     }
 }
 
-template <typename T>
-char const * ShakeSort<T>::name = "Shake sort";
+template <typename T, typename Compare, typename Projection>
+char const * ShakeSort<T, Compare, Projection>::name = "Shake sort";
 
 
 // -------------------------------------------------------------------------------
 // ----- QuickSort -----
 //
 
-template <typename T>
-void QuickSort<T>::sort(std::vector<T> & elements, int lo, int hi)
+template <typename T, typename Compare, typename Projection>
+void QuickSort<T, Compare, Projection>::sort(T * elements, std::ptrdiff_t lo, std::ptrdiff_t hi)
 {
     if (hi <= lo)
     {
         return;
     }
-    int j = partition(elements, lo, hi);
+    std::ptrdiff_t j = partition(elements, lo, hi);
     sort(elements, lo, j - 1);
     sort(elements, j + 1, hi);
 }
 
-template <typename T>
-int QuickSort<T>::partition(std::vector<T> & elements, int lo, int hi)
+template <typename T, typename Compare, typename Projection>
+std::ptrdiff_t QuickSort<T, Compare, Projection>::partition(T * elements, std::ptrdiff_t lo, std::ptrdiff_t hi)
 {
-    int i = lo;
-    int j = hi + 1;
+    std::ptrdiff_t i = lo;
+    std::ptrdiff_t j = hi + 1;
     T v = elements[lo];
     while (true)
     {
-        while (less(elements[++i], v))
+        while (less<T, Compare, Projection>(elements[++i], v))
         {
             if (i == hi)
                 break;
         }
-        while (less(v, elements[--j]))
+        while (less<T, Compare, Projection>(v, elements[--j]))
         {
             if (j == lo)
                 break;
@@ -174,38 +177,38 @@ int QuickSort<T>::partition(std::vector<T> & elements, int lo, int hi)
     return j;
 }
 
-template <typename T>
-char const * QuickSort<T>::name = "Quick sort";
+template <typename T, typename Compare, typename Projection>
+char const * QuickSort<T, Compare, Projection>::name = "Quick sort";
 
 
 // -------------------------------------------------------------------------------
 // ----- QuickSortM -----
 //
 
-template <typename T>
-void QuickSortM<T>::sort(std::vector<T> & elements, int lo, int hi)
+template <typename T, typename Compare, typename Projection>
+void QuickSortM<T, Compare, Projection>::sort(T * elements, std::ptrdiff_t lo, std::ptrdiff_t hi)
 {
     if (hi <= lo)
     {
         return;
     }
-    int j = partition(elements, lo, hi);
+    std::ptrdiff_t j = partition(elements, lo, hi);
     sort(elements, lo, j - 1);
     sort(elements, j + 1, hi);
 }
 
-template <typename T>
-int QuickSortM<T>::partition(std::vector<T> & elements, int lo, int hi)
+template <typename T, typename Compare, typename Projection>
+std::ptrdiff_t QuickSortM<T, Compare, Projection>::partition(T * elements, std::ptrdiff_t lo, std::ptrdiff_t hi)
 {
-    int i = lo;
-    int j = hi + 1;
-    int ind = lo;
+    std::ptrdiff_t i = lo;
+    std::ptrdiff_t j = hi + 1;
+    std::ptrdiff_t ind = lo;
 
     if (hi - lo >= 3)
     {
-        bool a_less_b = less(elements[lo], elements[lo + 1]);
-        bool b_less_c = less(elements[lo + 1], elements[lo + 2]);
-        bool c_less_a = less(elements[lo + 2], elements[lo]);
+        bool a_less_b = less<T, Compare, Projection>(elements[lo], elements[lo + 1]);
+        bool b_less_c = less<T, Compare, Projection>(elements[lo + 1], elements[lo + 2]);
+        bool c_less_a = less<T, Compare, Projection>(elements[lo + 2], elements[lo]);
 
         if (c_less_a && a_less_b)
             ind = lo;
@@ -224,12 +227,12 @@ int QuickSortM<T>::partition(std::vector<T> & elements, int lo, int hi)
 
     while (true)
     {
-        while (less(elements[++i], v))
+        while (less<T, Compare, Projection>(elements[++i], v))
         {
             if (i == hi)
                 break;
         }
-        while (less(v, elements[--j]))
+        while (less<T, Compare, Projection>(v, elements[--j]))
         {
             if (j == lo)
                 break;
@@ -242,48 +245,56 @@ int QuickSortM<T>::partition(std::vector<T> & elements, int lo, int hi)
     return j;
 }
 
-template <typename T>
-char const * QuickSortM<T>::name = "Quick sort median";
+template <typename T, typename Compare, typename Projection>
+char const * QuickSortM<T, Compare, Projection>::name = "Quick sort median";
 
 
 // -------------------------------------------------------------------------------
 // ----- Quick3Sort -----
 //
 
-template <typename T>
-void Quick3Sort<T>::sort(std::vector<T> & elements, int lo, int hi)
+template <typename T, typename Compare, typename Projection>
+void Quick3Sort<T, Compare, Projection>::sort(T * elements, std::ptrdiff_t lo, std::ptrdiff_t hi)
 {
     if (hi <= lo)
     {
         return;
     }
 
-    int lt = lo;
-    int i = lo + 1;
-    int gt = hi;
+    std::ptrdiff_t lt;
+    std::ptrdiff_t gt;
+    partition(elements, lo, hi, lt, gt);
+    sort(elements, lo, lt - 1);
+    sort(elements, gt + 1, hi);
+}
+
+template <typename T, typename Compare, typename Projection>
+void Quick3Sort<T, Compare, Projection>::partition(T * elements, std::ptrdiff_t lo, std::ptrdiff_t hi, std::ptrdiff_t & lt, std::ptrdiff_t & gt)
+{
+    lt = lo;
+    gt = hi;
+    std::ptrdiff_t i = lo + 1;
     T v = elements[lo];
 
     while (i <= gt)
     {
-        if (elements[i] == v)
+        if (less<T, Compare, Projection>(elements[i], v))
         {
-            i++;
+            std::swap(elements[lt++], elements[i++]);
         }
-        else if (less(elements[i], v))
+        else if (less<T, Compare, Projection>(v, elements[i]))
         {
-            std::swap(elements[lt++], elements[i++]);
+            std::swap(elements[i], elements[gt--]);
         }
         else
         {
-            std::swap(elements[i], elements[gt--]);
+            i++;
         }
     }
-    sort(elements, lo, lt - 1);
-    sort(elements, gt + 1, hi);
 }
 
-template <typename T>
-char const * Quick3Sort<T>::name = "Quick3 sort";
+template <typename T, typename Compare, typename Projection>
+char const * Quick3Sort<T, Compare, Projection>::name = "Quick3 sort";
 
 
 
@@ -291,37 +302,35 @@ char const * Quick3Sort<T>::name = "Quick3 sort";
 // ----- GnomeSort -----
 //
 
-template <typename T>
-void GnomeSort<T>::sort(std::vector<T> & elements)
+template <typename T, typename Compare, typename Projection>
+void GnomeSort<T, Compare, Projection>::sort(T * elements, size_t length)
 {
-    size_t length = elements.size();
     for (size_t i = 1; i < length; i++)
     {
-        for (size_t j = i; j > 0 && less(elements[j], elements[j - 1]); j--)
+        for (size_t j = i; j > 0 && less<T, Compare, Projection>(elements[j], elements[j - 1]); j--)
         {
             std::swap(elements[j], elements[j - 1]);
         }
     }
 }
 
-template <typename T>
-char const * GnomeSort<T>::name = "Gnome sort";
+template <typename T, typename Compare, typename Projection>
+char const * GnomeSort<T, Compare, Projection>::name = "Gnome sort";
 
 
 // -------------------------------------------------------------------------------
 // ----- SelectionSort -----
 //
 
-template <typename T>
-void SelectionSort<T>::sort(std::vector<T> & elements)
+template <typename T, typename Compare, typename Projection>
+void SelectionSort<T, Compare, Projection>::sort(T * elements, size_t length)
 {
-    size_t length = elements.size();
     for (size_t i = 0; i < length; i++)
     {
         size_t min = i;
         for (size_t j = i; j < length - 1; ++j)
         {
-            if (elements[min] != elements[j + 1] && less(elements[j + 1], elements[min]))
+            if (less<T, Compare, Projection>(elements[j + 1], elements[min]))
             {
                 min = j + 1;
             }
@@ -330,116 +339,129 @@ void SelectionSort<T>::sort(std::vector<T> & elements)
     }
 }
 
-template <typename T>
-char const * SelectionSort<T>::name = "Selection sort";
+template <typename T, typename Compare, typename Projection>
+char const * SelectionSort<T, Compare, Projection>::name = "Selection sort";
 
 
 // -------------------------------------------------------------------------------
 // ----- HeapSort -----
 //
 
-template <typename T>
-void HeapSort<T>::sort(std::vector<T> & elements)
+template <typename T, typename Compare, typename Projection>
+void HeapSort<T, Compare, Projection>::sort(T * array, size_t length)
 {
-    int length = static_cast<int>(elements.size());
+    //  1. make sorted tree
+    for (size_t i = length / 2; i-- > 0; )
     {
-        //  1. make sorted tree
-        for (int i = length / 2; i >= 0; i--)
-        {
-            sink(elements, i, length);
-        }
-
-        // 2. sort
-        while (length > 1)
-        {
-            std::swap(elements[0], elements[--length]);
-            sink(elements, 0, length);
+        sink(array, i, length);
+    }
 
-        }
+    // 2. sort
+    while (length > 1)
+    {
+        std::swap(array[0], array[--length]);
+        sink(array, 0, length);
     }
 }
 
 
-template <typename T>
-void HeapSort<T>::sink(std::vector<T> & elements, int pos, int length)
+template <typename T, typename Compare, typename Projection>
+void HeapSort<T, Compare, Projection>::sink(T * array, size_t pos, size_t length)
 {
     ++pos;
     while (2 * pos <= length)
     {
-        int j = 2 * pos;
-        if (j < length && less(elements[j - 1], elements[j]))
+        size_t j = 2 * pos;
+        if (j < length && less<T, Compare, Projection>(array[j - 1], array[j]))
             j++;
 
-        if (less(elements[j - 1], elements[pos - 1]))
+        if (less<T, Compare, Projection>(array[j - 1], array[pos - 1]))
             break;
-        std::swap(elements[j - 1], elements[pos - 1]);
+        std::swap(array[j - 1], array[pos - 1]);
         pos = j;
     }
 }
-template <typename T>
-char const * HeapSort<T>::name = "Heap sort";
+template <typename T, typename Compare, typename Projection>
+char const * HeapSort<T, Compare, Projection>::name = "Heap sort";
 
 
 // -------------------------------------------------------------------------------
 // ----- InsertionSort -----
 //
 
-template <typename T>
-void InsertionSort<T>::sort(std::vector<T> & elements)
+template <typename T, typename Compare, typename Projection>
+void InsertionSort<T, Compare, Projection>::sort(T * array, size_t length)
 {
-    int length = static_cast<int>(elements.size());
-    for (int i = 1; i < length; i++)
+    for (size_t i = 1; i < length; i++)
     {
-        T key = elements[i];
-        int j = i - 1;
+        T key = array[i];
+        std::ptrdiff_t j = static_cast<std::ptrdiff_t>(i) - 1;
 
-        while (j >= 0 && elements[j] > key)
+        while (j >= 0 && less<T, Compare, Projection>(key, array[j]))
         {
-            elements[j + 1] = elements[j];
+            array[j + 1] = array[j];
             --j;
         }
-        elements[j + 1] = key;
+        array[j + 1] = key;
     }
 }
 
-template <typename T>
-void InsertionSort<T>::sort(T *array, int length)
+template <typename T, typename Compare, typename Projection>
+char const * InsertionSort<T, Compare, Projection>::name = "Insertion sort";
+
+
+// -------------------------------------------------------------------------------
+// ----- SortingNetwork -----
+//
+
+template <typename T, typename Compare, typename Projection>
+void SortingNetwork<T, Compare, Projection>::sort(T * array, size_t length, std::true_type)
 {
-    for (int i = 1; i < length; i++)
-    {
-        T key = array[i];
-        int j = i - 1;
+    if (length < 2)
+        return;
+
+    const T padding = std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity()
+                                                           : std::numeric_limits<T>::max();
+    T block[SIZE];
+    std::copy(array, array + length, block);
+    std::fill(block + length, block + SIZE, padding);
 
-        while (j >= 0 && array[j] > key)
+    // Batcher odd-even merge sort: merges sorted runs of p elements into runs of 2p
+    for (size_t p = 1; p < SIZE; p += p)
+    {
+        for (size_t k = p; k >= 1; k /= 2)
         {
-            array[j + 1] = array[j];
-            --j;
+            for (size_t j = k % p; j + k < SIZE; j += k + k)
+            {
+                for (size_t i = 0; i < k; ++i)
+                {
+                    if ((i + j) / (p + p) == (i + j + k) / (p + p))
+                        compareExchange(block[i + j], block[i + j + k]);
+                }
+            }
         }
-        array[j + 1] = key;
     }
-}
 
-template <typename T>
-char const * InsertionSort<T>::name = "Insertion sort";
+    std::copy(block, block + length, array);
+}
 
 
 // -------------------------------------------------------------------------------
 // ----- ShellSort -----
 //
 
-template <typename T>
-void ShellSort<T>::sort(std::vector<T> & elements)
+template <typename T, typename Compare, typename Projection>
+void ShellSort<T, Compare, Projection>::sort(T * elements, size_t length)
 {
-    int length = static_cast<int>(elements.size());
-    int h = 1;
+    size_t h = 1;
     while (h < length / 3)
         h = 3 * h + 1;
 
     while (h >= 1)
     {
-        for (int i = h; i < length; i++)
+        for (size_t i = h; i < length; i++)
         {
-            for (int j = i; j >= h && less(elements[j], elements[j - h]); j -= h)
+            for (size_t j = i; j >= h && less<T, Compare, Projection>(elements[j], elements[j - h]); j -= h)
             {
                 std::swap(elements[j], elements[j - h]);
             }
@@ -448,140 +470,370 @@ void ShellSort<T>::sort(std::vector<T> & elements)
     }
 }
 
-template <typename T>
-char const * ShellSort<T>::name = "Shell sort";
+template <typename T, typename Compare, typename Projection>
+char const * ShellSort<T, Compare, Projection>::name = "Shell sort";
 
 
 // -------------------------------------------------------------------------------
 // ----- MergeSort -----
 //
 
-template <typename T>
-void MergeSort<T>::sort(std::vector<T> & elements, int lo, int hi, std::vector<T> & aux)
+template <typename T, typename Compare, typename Projection>
+void MergeSort<T, Compare, Projection>::sort(T * array, size_t length, std::vector<T> & buffer)
 {
-    if (hi <= lo)
+    if (buffer.size() < length)
+        buffer.resize(length);
+
+    if (length > 1)
+        sort(array, buffer.data(), 0, length, false);
+}
+
+template <typename T, typename Compare, typename Projection>
+void MergeSort<T, Compare, Projection>::sort(T * elements, T * aux, size_t lo, size_t hi, bool toAux)
+{
+    if (hi - lo == 1)
     {
+        if (toAux)
+            aux[lo] = std::move(elements[lo]);
         return;
     }
 
-    int mid = lo + (hi - lo) / 2;
+    // halves are sorted into the other array and merged back into the required one
+    size_t mid = lo + (hi - lo) / 2;
+    sort(elements, aux, lo, mid, !toAux);
+    sort(elements, aux, mid, hi, !toAux);
 
-    sort(elements, lo, mid, aux);
-    sort(elements, mid + 1, hi, aux);
-    merge(elements, lo, mid, hi, aux);
+    T * from = toAux ? elements : aux;
+    T * to = toAux ? aux : elements;
+    merge<T, Compare, Projection>(from + lo, from + mid, from + hi, to + lo);
 }
 
-template <typename T>
-void MergeSort<T>::merge(std::vector<T> & elements, int lo, int mid, int hi, std::vector<T> & aux)
+template <typename T, typename Compare, typename Projection>
+char const * MergeSort<T, Compare, Projection>::name = "Merge sort";
+
+
+// -------------------------------------------------------------------------------
+// ----- MergeUpSort -----
+//
+
+template <typename T, typename Compare, typename Projection>
+void MergeUpSort<T, Compare, Projection>::sort(T * array, size_t length, std::vector<T> & buffer)
 {
-    int i = lo;
-    int j = mid + 1;
+    if (buffer.size() < length)
+        buffer.resize(length);
 
-    // copying array to aux
-    for (int k = lo; k <= hi; k++)
+    T * from = array;
+    T * to = buffer.data();
+    for (size_t sz = 1; sz < length; sz += sz)
     {
-       aux[k] = elements[k];
+        for (size_t lo = 0; lo < length; lo += sz + sz)
+        {
+            size_t mid = std::min(lo + sz, length);
+            size_t hi = std::min(lo + sz + sz, length);
+            merge<T, Compare, Projection>(from + lo, from + mid, from + hi, to + lo);
+        }
+        std::swap(from, to);
     }
 
-    // copying array from aux
-    for (int k = lo; k <= hi; k++)
-    {
-        if (i > mid)
-            elements[k] = aux[j++]; // copy from right part
-        else
-            if (j > hi)
-                elements[k] = aux[i++]; // copy from left part
-            else
-                if (less(aux[j], aux[i]))
-                    elements[k] = aux[j++]; // copy from right part
-                else
-                    elements[k] = aux[i++]; // copy from left part
-    }
+    if (from != array)
+        std::move(from, from + length, array);
 }
 
-template <typename T>
-char const * MergeSort<T>::name = "Merge sort";
+template <typename T, typename Compare, typename Projection>
+char const * MergeUpSort<T, Compare, Projection>::name = "MergeUp sort";
 
 
 // -------------------------------------------------------------------------------
-// ----- MergeUpSort -----
+// ----- PowerSort -----
 //
 
-template <typename T>
-void MergeUpSort<T>::sort(std::vector<T> & elements, int length, std::vector<T> & aux)
+template <typename T, typename Compare, typename Projection>
+void PowerSort<T, Compare, Projection>::sort(T * data, size_t length)
 {
-    for (int sz = 1; sz < length; sz += sz)
+    if (length < 2)
+        return;
+
+    std::vector<T> buffer;
+    std::vector<Run> stack;
+
+    Run run = {0, nextRun(data, data + length), 0};
+    while (run.start + run.length < length)
     {
-        for (int lo = 0; lo < length - sz; lo += sz+sz)
+        const size_t start = run.start + run.length;
+        Run next = {start, nextRun(data + start, data + length), 0};
+        next.power = power(run, next, length);
+
+        // runs left from the boundaries deeper in the merge tree are merged first
+        while (!stack.empty() && run.power > next.power)
         {
-            merge(elements, lo, lo+sz-1, (lo + sz + sz - 1) < (length - 1) ? lo + sz + sz - 1 : length - 1, aux);
+            Run & top = stack.back();
+            merge(data + top.start, data + run.start, data + run.start + run.length, buffer);
+            run = {top.start, top.length + run.length, top.power};
+            stack.pop_back();
         }
+        stack.push_back(run);
+        run = next;
+    }
+
+    while (!stack.empty())
+    {
+        Run & top = stack.back();
+        merge(data + top.start, data + run.start, data + run.start + run.length, buffer);
+        run = {top.start, top.length + run.length, top.power};
+        stack.pop_back();
     }
 }
 
-template <typename T>
-void MergeUpSort<T>::merge(std::vector<T> & elements, int lo, int mid, int hi, std::vector<T> & aux)
+template <typename T, typename Compare, typename Projection>
+size_t PowerSort<T, Compare, Projection>::nextRun(T * first, T * last)
+{
+    T * end = first + 1;
+    if (end == last)
+        return 1;
+
+    // descending run should be strict, otherwise reversing breaks the order of equal elements
+    if (less<T, Compare, Projection>(*end, *first))
+    {
+        while (++end != last && less<T, Compare, Projection>(*end, *(end - 1)))
+            ;
+        std::reverse(first, end);
+    }
+    else
+    {
+        while (++end != last && !less<T, Compare, Projection>(*end, *(end - 1)))
+            ;
+    }
+
+    // extend the short run by binary insertion, equal elements are inserted after the old ones
+    T * minEnd = static_cast<size_t>(last - first) < MIN_RUN ? last : first + MIN_RUN;
+    for (; end < minEnd; ++end)
+    {
+        T * pos = std::upper_bound(first, end, *end, [](const T & a, const T & b) { return less<T, Compare, Projection>(a, b); });
+        T tmp = std::move(*end);
+        std::move_backward(pos, end, end + 1);
+        *pos = std::move(tmp);
+    }
+    return static_cast<size_t>(end - first);
+}
+
+template <typename T, typename Compare, typename Projection>
+unsigned PowerSort<T, Compare, Projection>::power(const Run & a, const Run & b, size_t n)
+{
+    // midpoints of the runs as the binary fractions of 2n, power is the first differing bit
+    size_t l = 2 * a.start + a.length;
+    size_t r = 2 * b.start + b.length;
+    const size_t n2 = 2 * n;
+    unsigned result = 0;
+    while (true)
+    {
+        ++result;
+        l *= 2;
+        r *= 2;
+        bool bitL = l >= n2;
+        bool bitR = r >= n2;
+        if (bitL != bitR)
+            return result;
+        if (bitL)
+        {
+            l -= n2;
+            r -= n2;
+        }
+    }
+}
+
+template <typename T, typename Compare, typename Projection>
+void PowerSort<T, Compare, Projection>::merge(T * first, T * mid, T * last, std::vector<T> & buffer)
 {
-    int i = lo;
-    int j = mid + 1;
+    // elements of the left run not greater than the first right element are in place already
+    const T & firstRight = *mid;
+    first = gallop(first, mid, [&firstRight](const T & x) { return !less<T, Compare, Projection>(firstRight, x); }, false);
+    if (first == mid)
+        return;
+
+    // the same is for elements of the right run not less than the last left element
+    const T & lastLeft = *(mid - 1);
+    last = gallop(mid, last, [&lastLeft](const T & x) { return less<T, Compare, Projection>(x, lastLeft); }, true);
+
+    if (mid - first <= last - mid)
+        mergeLo(first, mid, last, buffer);
+    else
+        mergeHi(first, mid, last, buffer);
+}
 
-    // copying array to aux
-    for (int k = lo; k <= hi; k++)
+template <typename T, typename Compare, typename Projection>
+void PowerSort<T, Compare, Projection>::mergeLo(T * first, T * mid, T * last, std::vector<T> & buffer)
+{
+    const size_t lengthL = static_cast<size_t>(mid - first);
+    if (buffer.size() < lengthL)
+        buffer.resize(lengthL);
+    std::move(first, mid, buffer.begin());
+
+    T * l = buffer.data();
+    T * endL = l + lengthL;
+    T * r = mid;
+    T * out = first;
+    size_t winsL = 0, winsR = 0;
+
+    while (l < endL && r < last)
     {
-       aux[k] = elements[k];
+        if (less<T, Compare, Projection>(*r, *l))
+        {
+            *out++ = std::move(*r++);
+            ++winsR;
+            winsL = 0;
+        }
+        else
+        {
+            *out++ = std::move(*l++);
+            ++winsL;
+            winsR = 0;
+        }
+
+        if (l == endL || r == last)
+            break;
+
+        if (winsL >= MIN_GALLOP)
+        {
+            const T & v = *r;
+            T * to = gallop(l, endL, [&v](const T & x) { return !less<T, Compare, Projection>(v, x); }, false);
+            out = std::move(l, to, out);
+            l = to;
+            winsL = 0;
+        }
+        else if (winsR >= MIN_GALLOP)
+        {
+            const T & v = *l;
+            T * to = gallop(r, last, [&v](const T & x) { return less<T, Compare, Projection>(x, v); }, false);
+            out = std::move(r, to, out);
+            r = to;
+            winsR = 0;
+        }
     }
 
-    // copying array from aux
-    for (int k = lo; k <= hi; k++)
+    // the rest of the right run is in place already
+    std::move(l, endL, out);
+}
+
+template <typename T, typename Compare, typename Projection>
+void PowerSort<T, Compare, Projection>::mergeHi(T * first, T * mid, T * last, std::vector<T> & buffer)
+{
+    const size_t lengthR = static_cast<size_t>(last - mid);
+    if (buffer.size() < lengthR)
+        buffer.resize(lengthR);
+    std::move(mid, last, buffer.begin());
+
+    T * l = mid;
+    T * beginR = buffer.data();
+    T * r = beginR + lengthR;
+    T * out = last;
+    size_t winsL = 0, winsR = 0;
+
+    while (l > first && r > beginR)
     {
-        if (i > mid)
-            elements[k] = aux[j++]; // copy from right part
+        if (less<T, Compare, Projection>(*(r - 1), *(l - 1)))
+        {
+            *--out = std::move(*--l);
+            ++winsL;
+            winsR = 0;
+        }
         else
-            if (j > hi)
-                elements[k] = aux[i++]; // copy from left part
-            else
-                if (less(aux[j], aux[i]))
-                    elements[k] = aux[j++]; // copy from right part
-                else
-                    elements[k] = aux[i++]; // copy from left part
+        {
+            *--out = std::move(*--r);
+            ++winsR;
+            winsL = 0;
+        }
+
+        if (l == first || r == beginR)
+            break;
+
+        if (winsL >= MIN_GALLOP)
+        {
+            const T & v = *(r - 1);
+            T * from = gallop(first, l, [&v](const T & x) { return !less<T, Compare, Projection>(v, x); }, true);
+            out = std::move_backward(from, l, out);
+            l = from;
+            winsL = 0;
+        }
+        else if (winsR >= MIN_GALLOP)
+        {
+            const T & v = *(l - 1);
+            T * from = gallop(beginR, r, [&v](const T & x) { return less<T, Compare, Projection>(x, v); }, true);
+            out = std::move_backward(from, r, out);
+            r = from;
+            winsR = 0;
+        }
     }
+
+    // the rest of the left run is in place already
+    std::move_backward(beginR, r, out);
 }
-template <typename T>
-char const * MergeUpSort<T>::name = "MergeUp sort";
+
+template <typename T, typename Compare, typename Projection>
+template <typename Pred>
+T * PowerSort<T, Compare, Projection>::gallop(T * first, T * last, Pred pred, bool fromRight)
+{
+    const size_t length = static_cast<size_t>(last - first);
+    size_t lo = 0;
+    size_t hi = length;
+    size_t step = 1;
+    if (fromRight)
+    {
+        while (step <= hi && !pred(first[hi - step]))
+        {
+            hi -= step;
+            step *= 2;
+        }
+        lo = step <= hi ? hi - step + 1 : 0;
+    }
+    else
+    {
+        while (lo + step <= length && pred(first[lo + step - 1]))
+        {
+            lo += step;
+            step *= 2;
+        }
+        hi = std::min(length, lo + step - 1);
+    }
+    return std::partition_point(first + lo, first + hi, pred);
+}
+
+template <typename T, typename Compare, typename Projection>
+char const * PowerSort<T, Compare, Projection>::name = "Power sort";
 
 
 // -------------------------------------------------------------------------------
 // ----- QuickInsSort -----
 //
 
-template <typename T>
-void QuickInsSort<T>::sort(std::vector<T> & elements, int lo, int hi)
+template <typename T, typename Compare, typename Projection>
+void QuickInsSort<T, Compare, Projection>::sort(T * elements, std::ptrdiff_t lo, std::ptrdiff_t hi)
 {
-    if (hi - lo <= 15)
+    if (hi - lo < static_cast<std::ptrdiff_t>(SortingNetwork<T, Compare, Projection>::SIZE))
     {
-        InsertionSort<T>{}.sort(&elements[lo], hi - lo + 1);
+        if (hi > lo)
+            SortingNetwork<T, Compare, Projection>::sort(elements + lo, static_cast<size_t>(hi - lo + 1));
         return;
     }
 
-    int j = partition(elements, lo, hi);
+    std::ptrdiff_t j = partition(elements, lo, hi);
     sort(elements, lo, j - 1);
     sort(elements, j + 1, hi);
 }
 
-template <typename T>
-int QuickInsSort<T>::partition(std::vector<T> & elements, int lo, int hi)
+template <typename T, typename Compare, typename Projection>
+std::ptrdiff_t QuickInsSort<T, Compare, Projection>::partition(T * elements, std::ptrdiff_t lo, std::ptrdiff_t hi)
 {
-    int i = lo;
-    int j = hi + 1;
+    std::ptrdiff_t i = lo;
+    std::ptrdiff_t j = hi + 1;
     T v = elements[lo];
     while (true)
     {
-        while (less(elements[++i], v))
+        while (less<T, Compare, Projection>(elements[++i], v))
         {
             if (i == hi)
                 break;
         }
-        while (less(v, elements[--j]))
+        while (less<T, Compare, Projection>(v, elements[--j]))
         {
             if (j == lo)
                 break;
@@ -594,88 +846,1094 @@ int QuickInsSort<T>::partition(std::vector<T> & elements, int lo, int hi)
     return j;
 }
 
-template <typename T>
-char const * QuickInsSort<T>::name = "QuickIns sort";
+template <typename T, typename Compare, typename Projection>
+char const * QuickInsSort<T, Compare, Projection>::name = "QuickIns sort";
 
 
 // -------------------------------------------------------------------------------
-// ----- MergeInsSort -----
+// ----- PdqSort -----
 //
 
-template <typename T>
-void MergeInsSort<T>::sort(std::vector<T> & elements, int lo, int hi, std::vector<T> & aux)
+template <typename T, typename Compare, typename Projection>
+void PdqSort<T, Compare, Projection>::sort(T * array, size_t length)
 {
-    if (hi - lo <= 15)
-    {
-        InsertionSort<T>{}.sort(&elements[lo], hi - lo + 1);
+    T * first = array;
+    T * last = first + length;
+    if (last - first < 2)
         return;
+
+    // sorted or reversed input is handled in one pass
+    T * run = first + 1;
+    while (run != last && !less<T, Compare, Projection>(*run, *(run - 1)))
+        ++run;
+    if (run == last)
+        return;
+
+    if (run == first + 1)
+    {
+        while (run != last && less<T, Compare, Projection>(*run, *(run - 1)))
+            ++run;
+        if (run == last)
+        {
+            std::reverse(first, last);
+            return;
+        }
     }
 
-    int mid = lo + (hi - lo) / 2;
+    size_t badAllowed = 0;
+    for (; length > 1; length >>= 1)
+        ++badAllowed;
 
-    sort(elements, lo, mid, aux);
-    sort(elements, mid + 1, hi, aux);
-    merge(elements, lo, mid, hi, aux);
+    sort(first, last, badAllowed, true);
 }
 
-
-template <typename T>
-void MergeInsSort<T>::merge(std::vector<T> & elements, int lo, int mid, int hi, std::vector<T> & aux)
+template <typename T, typename Compare, typename Projection>
+void PdqSort<T, Compare, Projection>::sort(T * first, T * last, size_t badAllowed, bool leftmost)
 {
-    int i = lo;
-    int j = mid + 1;
-
-    // copying array to aux
-    for (int k = lo; k <= hi; k++)
+    while (true)
     {
-       aux[k] = elements[k];
+        size_t length = static_cast<size_t>(last - first);
+        if (length < INSERTION_CUTOFF)
+        {
+            insertionSort(first, last, leftmost);
+            return;
+        }
+
+        // 1. move the pivot to the first place
+        size_t half = length / 2;
+        if (length > NINTHER_CUTOFF)
+        {
+            sort3(first, first + half, last - 1);
+            sort3(first + 1, first + (half - 1), last - 2);
+            sort3(first + 2, first + (half + 1), last - 3);
+            sort3(first + (half - 1), first + half, first + (half + 1));
+            std::swap(*first, *(first + half));
+        }
+        else
+        {
+            sort3(first + half, first, last - 1);
+        }
+
+        // 2. pivot equal to the left neighbour is the least element, skip elements equal to it
+        if (!leftmost && !less<T, Compare, Projection>(*(first - 1), *first))
+        {
+            first = partitionLeft(first, last) + 1;
+            continue;
+        }
+
+        // 3. partition
+        std::pair<T *, bool> partition = partitionRight(first, last);
+        T * pivot = partition.first;
+        size_t leftLength = static_cast<size_t>(pivot - first);
+        size_t rightLength = static_cast<size_t>(last - (pivot + 1));
+
+        if (leftLength < length / 8 || rightLength < length / 8)
+        {
+            if (--badAllowed == 0)
+            {
+                HeapSort<T, Compare, Projection>::sort(first, length);
+                return;
+            }
+
+            // shuffle elements which may become pivots next time
+            if (leftLength >= INSERTION_CUTOFF)
+            {
+                std::swap(*first, *(first + leftLength / 4));
+                std::swap(*(pivot - 1), *(pivot - leftLength / 4));
+                if (leftLength > NINTHER_CUTOFF)
+                {
+                    std::swap(*(first + 1), *(first + (leftLength / 4 + 1)));
+                    std::swap(*(first + 2), *(first + (leftLength / 4 + 2)));
+                    std::swap(*(pivot - 2), *(pivot - (leftLength / 4 + 1)));
+                    std::swap(*(pivot - 3), *(pivot - (leftLength / 4 + 2)));
+                }
+            }
+            if (rightLength >= INSERTION_CUTOFF)
+            {
+                std::swap(*(pivot + 1), *(pivot + (1 + rightLength / 4)));
+                std::swap(*(last - 1), *(last - rightLength / 4));
+                if (rightLength > NINTHER_CUTOFF)
+                {
+                    std::swap(*(pivot + 2), *(pivot + (2 + rightLength / 4)));
+                    std::swap(*(pivot + 3), *(pivot + (3 + rightLength / 4)));
+                    std::swap(*(last - 2), *(last - (1 + rightLength / 4)));
+                    std::swap(*(last - 3), *(last - (2 + rightLength / 4)));
+                }
+            }
+        }
+        else if (partition.second && partialInsertionSort(first, pivot) && partialInsertionSort(pivot + 1, last))
+        {
+            return;
+        }
+
+        // 4. recursion into the smaller part keeps the stack depth logarithmic
+        if (leftLength < rightLength)
+        {
+            sort(first, pivot, badAllowed, leftmost);
+            first = pivot + 1;
+            leftmost = false;
+        }
+        else
+        {
+            sort(pivot + 1, last, badAllowed, false);
+            last = pivot;
+        }
     }
+}
 
-    // copying array from aux
-    for (int k = lo; k <= hi; k++)
+template <typename T, typename Compare, typename Projection>
+void PdqSort<T, Compare, Projection>::insertionSort(T * first, T * last, bool leftmost)
+{
+    for (T * current = first + 1; current < last; ++current)
     {
-        if (i > mid)
-            elements[k] = aux[j++]; // copy from right part
-        else
-            if (j > hi)
-                elements[k] = aux[i++]; // copy from left part
-            else
-                if (less(aux[j], aux[i]))
-                    elements[k] = aux[j++]; // copy from right part
-                else
-                    elements[k] = aux[i++]; // copy from left part
+        if (!less<T, Compare, Projection>(*current, *(current - 1)))
+            continue;
+
+        T tmp = std::move(*current);
+        T * sift = current;
+        // element before the range stops the loop when the range is not leftmost
+        do
+        {
+            *sift = std::move(*(sift - 1));
+            --sift;
+        }
+        while ((!leftmost || sift != first) && less<T, Compare, Projection>(tmp, *(sift - 1)));
+        *sift = std::move(tmp);
     }
 }
 
-template <typename T>
-char const * MergeInsSort<T>::name = "MergeIns sort";
+template <typename T, typename Compare, typename Projection>
+bool PdqSort<T, Compare, Projection>::partialInsertionSort(T * first, T * last)
+{
+    size_t moves = 0;
+    for (T * current = first + 1; current < last; ++current)
+    {
+        if (!less<T, Compare, Projection>(*current, *(current - 1)))
+            continue;
 
+        T tmp = std::move(*current);
+        T * sift = current;
+        do
+        {
+            *sift = std::move(*(sift - 1));
+            --sift;
+        }
+        while (sift != first && less<T, Compare, Projection>(tmp, *(sift - 1)));
+        *sift = std::move(tmp);
 
-// -------------------------------------------------------------------------------
-// ----- InsertionBinarySort -----
-//
+        moves += static_cast<size_t>(current - sift);
+        if (moves > PARTIAL_INSERTION_LIMIT)
+            return false;
+    }
+    return true;
+}
 
-template <typename T>
-void InsertionBinarySort<T>::sort(std::vector<T> & elements)
+template <typename T, typename Compare, typename Projection>
+void PdqSort<T, Compare, Projection>::sort3(T * a, T * b, T * c)
 {
-     // TODO: implement InsertionBinary sort
-    int length = static_cast<int>(elements.size());
-    for (int i = 1; i < length; i++)
+    if (less<T, Compare, Projection>(*b, *a))
+        std::swap(*a, *b);
+    if (less<T, Compare, Projection>(*c, *b))
+        std::swap(*b, *c);
+    if (less<T, Compare, Projection>(*b, *a))
+        std::swap(*a, *b);
+}
+
+template <typename T, typename Compare, typename Projection>
+std::pair<T *, bool> PdqSort<T, Compare, Projection>::partitionRight(T * begin, T * end)
+{
+    T pivot = std::move(*begin);
+    T * first = begin;
+    T * last = end;
+
+    // median of 3 guarantees that there is an element not less than pivot on the right
+    while (less<T, Compare, Projection>(*++first, pivot))
+        ;
+
+    // there is an element less than pivot on the left unless no element was skipped
+    if (first - 1 == begin)
     {
-        T key = elements[i];
-        int j = i - 1;
+        while (first < last && !less<T, Compare, Projection>(*--last, pivot))
+            ;
+    }
+    else
+    {
+        while (!less<T, Compare, Projection>(*--last, pivot))
+            ;
+    }
 
-        while (j >= 0 && elements[j] > key)
+    bool alreadyPartitioned = first >= last;
+    if (!alreadyPartitioned)
+    {
+        std::swap(*first, *last);
+        ++first;
+
+        // offsets of the elements which should go to the other side
+        unsigned char offsetsL[BLOCK_SIZE];
+        unsigned char offsetsR[BLOCK_SIZE];
+        size_t countL = 0, countR = 0;
+        size_t startL = 0, startR = 0;
+
+        while (static_cast<size_t>(last - first) > 2 * BLOCK_SIZE)
         {
-            elements[j + 1] = elements[j];
-            --j;
+            if (countL == 0)
+            {
+                startL = 0;
+                T * it = first;
+                for (size_t i = 0; i < BLOCK_SIZE; ++i, ++it)
+                {
+                    offsetsL[countL] = static_cast<unsigned char>(i);
+                    countL += !less<T, Compare, Projection>(*it, pivot);
+                }
+            }
+            if (countR == 0)
+            {
+                startR = 0;
+                T * it = last;
+                for (size_t i = 0; i < BLOCK_SIZE; ++i)
+                {
+                    offsetsR[countR] = static_cast<unsigned char>(i + 1);
+                    countR += less<T, Compare, Projection>(*--it, pivot);
+                }
+            }
+
+            size_t count = std::min(countL, countR);
+            swapOffsets(first, last, offsetsL + startL, offsetsR + startR, count, countL == countR);
+            countL -= count;
+            countR -= count;
+            startL += count;
+            startR += count;
+            if (countL == 0)
+                first += BLOCK_SIZE;
+            if (countR == 0)
+                last -= BLOCK_SIZE;
         }
-        elements[j + 1] = key;
+
+        // the rest is split into two blocks, the unfinished block keeps its size
+        size_t unknown = static_cast<size_t>(last - first) - ((countL || countR) ? static_cast<size_t>(BLOCK_SIZE) : 0);
+        size_t sizeL = 0, sizeR = 0;
+        if (countR)
+        {
+            sizeL = unknown;
+            sizeR = BLOCK_SIZE;
+        }
+        else if (countL)
+        {
+            sizeL = BLOCK_SIZE;
+            sizeR = unknown;
+        }
+        else
+        {
+            sizeL = unknown / 2;
+            sizeR = unknown - sizeL;
+        }
+
+        if (unknown && !countL)
+        {
+            startL = 0;
+            T * it = first;
+            for (size_t i = 0; i < sizeL; ++i, ++it)
+            {
+                offsetsL[countL] = static_cast<unsigned char>(i);
+                countL += !less<T, Compare, Projection>(*it, pivot);
+            }
+        }
+        if (unknown && !countR)
+        {
+            startR = 0;
+            T * it = last;
+            for (size_t i = 0; i < sizeR; ++i)
+            {
+                offsetsR[countR] = static_cast<unsigned char>(i + 1);
+                countR += less<T, Compare, Projection>(*--it, pivot);
+            }
+        }
+
+        size_t count = std::min(countL, countR);
+        swapOffsets(first, last, offsetsL + startL, offsetsR + startR, count, countL == countR);
+        countL -= count;
+        countR -= count;
+        startL += count;
+        startR += count;
+        if (countL == 0)
+            first += sizeL;
+        if (countR == 0)
+            last -= sizeR;
+
+        // only one side has misplaced elements now, they are moved to the border
+        if (countL)
+        {
+            while (countL--)
+                std::swap(*(first + offsetsL[startL + countL]), *--last);
+            first = last;
+        }
+        if (countR)
+        {
+            while (countR--)
+            {
+                std::swap(*(last - offsetsR[startR + countR]), *first);
+                ++first;
+            }
+            last = first;
+        }
+    }
+
+    T * pivotPos = first - 1;
+    *begin = std::move(*pivotPos);
+    *pivotPos = std::move(pivot);
+    return std::make_pair(pivotPos, alreadyPartitioned);
+}
+
+template <typename T, typename Compare, typename Projection>
+T * PdqSort<T, Compare, Projection>::partitionLeft(T * begin, T * end)
+{
+    T pivot = std::move(*begin);
+    T * first = begin;
+    T * last = end;
+
+    while (less<T, Compare, Projection>(pivot, *--last))
+        ;
+
+    if (last + 1 == end)
+    {
+        while (first < last && !less<T, Compare, Projection>(pivot, *++first))
+            ;
+    }
+    else
+    {
+        while (!less<T, Compare, Projection>(pivot, *++first))
+            ;
+    }
+
+    while (first < last)
+    {
+        std::swap(*first, *last);
+        while (less<T, Compare, Projection>(pivot, *--last))
+            ;
+        while (!less<T, Compare, Projection>(pivot, *++first))
+            ;
+    }
+
+    *begin = std::move(*last);
+    *last = std::move(pivot);
+    return last;
+}
+
+template <typename T, typename Compare, typename Projection>
+void PdqSort<T, Compare, Projection>::swapOffsets(T * first, T * last, const unsigned char * offsetsL, const unsigned char * offsetsR, size_t count, bool useSwaps)
+{
+    if (useSwaps)
+    {
+        for (size_t i = 0; i < count; ++i)
+            std::swap(*(first + offsetsL[i]), *(last - offsetsR[i]));
+    }
+    else if (count > 0)
+    {
+        // one cycle of moves instead of the swaps: three moves per swap are replaced by two
+        T * l = first + offsetsL[0];
+        T * r = last - offsetsR[0];
+        T tmp = std::move(*l);
+        *l = std::move(*r);
+        for (size_t i = 1; i < count; ++i)
+        {
+            l = first + offsetsL[i];
+            *r = std::move(*l);
+            r = last - offsetsR[i];
+            *l = std::move(*r);
+        }
+        *r = std::move(tmp);
+    }
+}
+
+template <typename T, typename Compare, typename Projection>
+char const * PdqSort<T, Compare, Projection>::name = "Pdq sort";
+
+
+// -------------------------------------------------------------------------------
+// ----- MergeInsSort -----
+//
+
+template <typename T, typename Compare, typename Projection>
+void MergeInsSort<T, Compare, Projection>::sort(T * array, size_t length, std::vector<T> & buffer)
+{
+    if (buffer.size() < length)
+        buffer.resize(length);
+
+    if (length > 1)
+        sort(array, buffer.data(), 0, length, false);
+}
+
+template <typename T, typename Compare, typename Projection>
+void MergeInsSort<T, Compare, Projection>::sort(T * elements, T * aux, size_t lo, size_t hi, bool toAux)
+{
+    if (hi - lo <= SortingNetwork<T, Compare, Projection>::SIZE)
+    {
+        SortingNetwork<T, Compare, Projection>::sort(elements + lo, hi - lo);
+        if (toAux)
+            std::move(elements + lo, elements + hi, aux + lo);
+        return;
+    }
+
+    size_t mid = lo + (hi - lo) / 2;
+    sort(elements, aux, lo, mid, !toAux);
+    sort(elements, aux, mid, hi, !toAux);
+
+    T * from = toAux ? elements : aux;
+    T * to = toAux ? aux : elements;
+    merge<T, Compare, Projection>(from + lo, from + mid, from + hi, to + lo);
+}
+
+template <typename T, typename Compare, typename Projection>
+char const * MergeInsSort<T, Compare, Projection>::name = "MergeIns sort";
+
+
+// -------------------------------------------------------------------------------
+// ----- InsertionBinarySort -----
+//
+
+template <typename T, typename Compare, typename Projection>
+void InsertionBinarySort<T, Compare, Projection>::sort(T * elements, size_t length)
+{
+     // TODO: implement InsertionBinary sort
+    for (size_t i = 1; i < length; i++)
+    {
+        T key = elements[i];
+        std::ptrdiff_t j = static_cast<std::ptrdiff_t>(i) - 1;
+
+        while (j >= 0 && less<T, Compare, Projection>(key, elements[j]))
+        {
+            elements[j + 1] = elements[j];
+            --j;
+        }
+        elements[j + 1] = key;
+    }
+}
+
+template <typename T, typename Compare, typename Projection>
+char const * InsertionBinarySort<T, Compare, Projection>::name = "InsertionBinary sort";
+
+
+// -------------------------------------------------------------------------------
+// ----- ParallelMergeSort -----
+//
+
+template <typename T, typename Compare, typename Projection>
+void ParallelMergeSort<T, Compare, Projection>::sort(T * array, size_t length, tools::TaskPool & pool)
+{
+    std::vector<T> aux(length);
+    sort(array, aux.data(), 0, length, false, pool);
+}
+
+template <typename T, typename Compare, typename Projection>
+void ParallelMergeSort<T, Compare, Projection>::sort(T * a, T * b, size_t lo, size_t hi, bool toB, tools::TaskPool & pool)
+{
+    if (hi - lo <= CUTOFF)
+    {
+        if (toB)
+        {
+            std::copy(a + lo, a + hi, b + lo);
+            sequentialSort(b, a, lo, hi);
+        }
+        else
+        {
+            sequentialSort(a, b, lo, hi);
+        }
+        return;
+    }
+
+    // halves are sorted into the other buffer and merged back
+    size_t mid = lo + (hi - lo) / 2;
+    pool.run([&]() { sort(a, b, lo, mid, !toB, pool); },
+             [&]() { sort(a, b, mid, hi, !toB, pool); });
+
+    if (toB)
+        merge(a, b, lo, mid, hi, pool);
+    else
+        merge(b, a, lo, mid, hi, pool);
+}
+
+template <typename T, typename Compare, typename Projection>
+void ParallelMergeSort<T, Compare, Projection>::sequentialSort(T * elements, T * aux, size_t lo, size_t hi)
+{
+    if (hi - lo <= INSERTION_CUTOFF)
+    {
+        InsertionSort<T, Compare, Projection>{}.sort(elements + lo, hi - lo);
+        return;
+    }
+
+    size_t mid = lo + (hi - lo) / 2;
+    sequentialSort(elements, aux, lo, mid);
+    sequentialSort(elements, aux, mid, hi);
+
+    std::copy(elements + lo, elements + hi, aux + lo);
+    merge(aux + lo, aux + mid, aux + mid, aux + hi, elements + lo);
+}
+
+template <typename T, typename Compare, typename Projection>
+void ParallelMergeSort<T, Compare, Projection>::merge(const T * src, T * dst, size_t lo, size_t mid, size_t hi, tools::TaskPool & pool)
+{
+    const size_t chunks = (hi - lo + CUTOFF - 1) / CUTOFF;
+    std::vector<std::function<void()>> tasks;
+    tasks.reserve(chunks);
+    for (size_t c = 0; c < chunks; ++c)
+    {
+        tasks.push_back([src, dst, lo, mid, hi, chunks, c]()
+        {
+            size_t first = (hi - lo) * c / chunks;
+            size_t last = (hi - lo) * (c + 1) / chunks;
+            size_t i0 = coRank(src, lo, mid, hi, first);
+            size_t i1 = coRank(src, lo, mid, hi, last);
+            merge(src + lo + i0, src + lo + i1,
+                  src + mid + (first - i0), src + mid + (last - i1),
+                  dst + lo + first);
+        });
+    }
+    pool.run(tasks);
+}
+
+template <typename T, typename Compare, typename Projection>
+void ParallelMergeSort<T, Compare, Projection>::merge(const T * a, const T * aEnd, const T * b, const T * bEnd, T * out)
+{
+    while (a != aEnd && b != bEnd)
+    {
+        if (less<T, Compare, Projection>(*b, *a))
+            *out++ = *b++; // copy from right part
+        else
+            *out++ = *a++; // copy from left part
+    }
+    out = std::copy(a, aEnd, out);
+    std::copy(b, bEnd, out);
+}
+
+template <typename T, typename Compare, typename Projection>
+size_t ParallelMergeSort<T, Compare, Projection>::coRank(const T * src, size_t lo, size_t mid, size_t hi, size_t k)
+{
+    // the smallest i such that the left element i is not needed before the right element k - i - 1;
+    // equal elements are taken from the left part first to keep the sort stable
+    const size_t leftSize = mid - lo;
+    const size_t rightSize = hi - mid;
+    size_t iLo = k > rightSize ? k - rightSize : 0;
+    size_t iHi = k < leftSize ? k : leftSize;
+    while (iLo < iHi)
+    {
+        size_t i = iLo + (iHi - iLo) / 2;
+        size_t j = k - i;
+        if (j > 0 && !less<T, Compare, Projection>(src[mid + j - 1], src[lo + i]))
+            iLo = i + 1;
+        else
+            iHi = i;
+    }
+    return iLo;
+}
+
+template <typename T, typename Compare, typename Projection>
+char const * ParallelMergeSort<T, Compare, Projection>::name = "ParallelMerge sort";
+
+
+// -------------------------------------------------------------------------------
+// ----- ParallelQuickSort -----
+//
+
+template <typename T, typename Compare, typename Projection>
+void ParallelQuickSort<T, Compare, Projection>::sort(T * array, size_t length, tools::TaskPool & pool)
+{
+    const size_t buckets = std::min(std::min<size_t>(MAX_BUCKETS, BUCKETS_PER_THREAD * (pool.threads() + 1)), length / CUTOFF);
+    if (buckets < 2)
+    {
+        PdqSort<T, Compare, Projection>::sort(array, length);
+        return;
+    }
+
+    // 1. splitters are evenly spaced elements of the sorted sample
+    std::vector<T> sample;
+    const size_t sampleSize = buckets * OVERSAMPLING;
+    sample.reserve(sampleSize);
+    for (size_t i = 0; i < sampleSize; ++i)
+        sample.push_back(array[i * length / sampleSize]);
+    PdqSort<T, Compare, Projection>::sort(sample);
+    std::vector<T> splitters;
+    for (size_t k = 1; k < buckets; ++k)
+        splitters.push_back(sample[k * OVERSAMPLING]);
+
+    // 2. every block counts its elements of every bucket, bucket k gets elements not less than
+    // splitter k - 1 and less than splitter k
+    const size_t blocks = buckets;
+    std::vector<uint8_t> bucketOf(length);
+    std::vector<size_t> offsets(blocks * buckets, 0);
+    parallelFor(blocks, [&](size_t b)
+    {
+        for (size_t i = length * b / blocks; i < length * (b + 1) / blocks; ++i)
+        {
+            auto k = std::upper_bound(splitters.begin(), splitters.end(), array[i],
+                                      [](const T & x, const T & y) { return less<T, Compare, Projection>(x, y); }) - splitters.begin();
+            bucketOf[i] = static_cast<uint8_t>(k);
+            ++offsets[b * buckets + static_cast<size_t>(k)];
+        }
+    }, pool);
+
+    // 3. counts become offsets of the parts of the blocks in the buckets
+    std::vector<size_t> starts(buckets + 1, 0);
+    for (size_t k = 0, offset = 0; k < buckets; ++k)
+    {
+        starts[k] = offset;
+        for (size_t b = 0; b < blocks; ++b)
+        {
+            size_t count = offsets[b * buckets + k];
+            offsets[b * buckets + k] = offset;
+            offset += count;
+        }
+    }
+    starts[buckets] = length;
+
+    // 4. blocks move their elements into the buckets, 5. buckets are sorted and moved back
+    std::vector<T> aux(length);
+    parallelFor(blocks, [&](size_t b)
+    {
+        size_t * offset = offsets.data() + b * buckets;
+        for (size_t i = length * b / blocks; i < length * (b + 1) / blocks; ++i)
+            aux[offset[bucketOf[i]]++] = std::move(array[i]);
+    }, pool);
+    parallelFor(buckets, [&](size_t k)
+    {
+        PdqSort<T, Compare, Projection>::sort(aux.data() + starts[k], starts[k + 1] - starts[k]);
+        std::move(aux.begin() + static_cast<std::ptrdiff_t>(starts[k]), aux.begin() + static_cast<std::ptrdiff_t>(starts[k + 1]), array + starts[k]);
+    }, pool);
+}
+
+template <typename T, typename Compare, typename Projection>
+template <typename Function>
+void ParallelQuickSort<T, Compare, Projection>::parallelFor(size_t count, Function f, tools::TaskPool & pool)
+{
+    std::vector<std::function<void()>> tasks;
+    tasks.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+        tasks.push_back([&f, i]() { f(i); });
+    pool.run(tasks);
+}
+
+template <typename T, typename Compare, typename Projection>
+char const * ParallelQuickSort<T, Compare, Projection>::name = "ParallelQuick sort";
+
+
+// -------------------------------------------------------------------------------
+// ----- KeyedSort -----
+//
+
+template <typename T, typename KeyFunction, template <typename...> class Sorter, typename Compare>
+void KeyedSort<T, KeyFunction, Sorter, Compare>::sort(T * array, size_t length)
+{
+    std::vector<Item> items;
+    items.reserve(length);
+    for (size_t i = 0; i < length; ++i)
+    {
+        items.emplace_back(KeyFunction()(array[i]), i);
+    }
+
+    Sorter<Item, ItemCompare>::sort(items);
+
+    std::vector<T> sorted;
+    sorted.reserve(length);
+    for (const auto & item : items)
+    {
+        sorted.push_back(std::move(array[item.second]));
+    }
+    std::move(sorted.begin(), sorted.end(), array);
+}
+
+template <typename T, typename KeyFunction, template <typename...> class Sorter, typename Compare>
+char const * KeyedSort<T, KeyFunction, Sorter, Compare>::name = "Keyed sort";
+
+
+// -------------------------------------------------------------------------------
+// ----- BoundSort -----
+//
+
+template <typename T, template <typename...> class Sorter, typename Compare, typename Projection>
+void BoundSort<T, Sorter, Compare, Projection>::sort(T * array, size_t length) const
+{
+    std::vector<Handle> handles;
+    handles.reserve(length);
+    for (size_t i = 0; i < length; ++i)
+    {
+        handles.push_back(Handle{array + i, this});
+    }
+
+    Sorter<Handle, HandleCompare>::sort(handles);
+
+    std::vector<T> sorted;
+    sorted.reserve(length);
+    for (const auto & handle : handles)
+    {
+        sorted.push_back(std::move(*handle.element));
+    }
+    std::move(sorted.begin(), sorted.end(), array);
+}
+
+template <typename T, template <typename...> class Sorter, typename Compare, typename Projection>
+char const * BoundSort<T, Sorter, Compare, Projection>::name = "Bound sort";
+
+
+// -------------------------------------------------------------------------------
+// ----- QuickSelect -----
+//
+
+template <typename T, typename Compare, typename Projection>
+void QuickSelect<T, Compare, Projection>::select(T * array, size_t length, size_t k)
+{
+    if (k >= length)
+        return;
+
+    std::ptrdiff_t lo = 0;
+    std::ptrdiff_t hi = static_cast<std::ptrdiff_t>(length) - 1;
+    const std::ptrdiff_t target = static_cast<std::ptrdiff_t>(k);
+
+    size_t stepsAllowed = 0;
+    for (; length > 1; length >>= 1)
+        stepsAllowed += 2;
+
+    while (hi - lo >= static_cast<std::ptrdiff_t>(INSERTION_CUTOFF))
+    {
+        if (stepsAllowed-- == 0)
+        {
+            HeapSort<T, Compare, Projection>::sort(array + lo, static_cast<size_t>(hi - lo + 1));
+            return;
+        }
+
+        // median of three becomes the pivot
+        std::ptrdiff_t mid = lo + (hi - lo) / 2;
+        if (less<T, Compare, Projection>(array[mid], array[lo]))
+            std::swap(array[mid], array[lo]);
+        if (less<T, Compare, Projection>(array[hi], array[lo]))
+            std::swap(array[hi], array[lo]);
+        if (less<T, Compare, Projection>(array[hi], array[mid]))
+            std::swap(array[hi], array[mid]);
+        std::swap(array[lo], array[mid]);
+
+        std::ptrdiff_t lt;
+        std::ptrdiff_t gt;
+        Quick3Sort<T, Compare, Projection>::partition(array, lo, hi, lt, gt);
+        if (target < lt)
+            hi = lt - 1;
+        else if (target > gt)
+            lo = gt + 1;
+        else
+            return;
+    }
+    InsertionSort<T, Compare, Projection>::sort(array + lo, static_cast<size_t>(hi - lo + 1));
+}
+
+template <typename T, typename Compare, typename Projection>
+char const * QuickSelect<T, Compare, Projection>::name = "Quick select";
+
+
+// -------------------------------------------------------------------------------
+// ----- FloydRivestSelect -----
+//
+
+template <typename T, typename Compare, typename Projection>
+void FloydRivestSelect<T, Compare, Projection>::select(T * elements, std::ptrdiff_t left, std::ptrdiff_t right, std::ptrdiff_t k)
+{
+    while (right > left)
+    {
+        if (right - left > SAMPLE_CUTOFF)
+        {
+            // the sample of size s around k is selected so that the element k of the range gets
+            // into it with high probability
+            const double n = static_cast<double>(right - left + 1);
+            const double i = static_cast<double>(k - left + 1);
+            const double z = std::log(n);
+            const double s = 0.5 * std::exp(2 * z / 3);
+            const double sd = 0.5 * std::sqrt(z * s * (n - s) / n) * (i < n / 2 ? -1 : 1);
+            const std::ptrdiff_t sampleLeft = std::max(left, static_cast<std::ptrdiff_t>(k - i * s / n + sd));
+            const std::ptrdiff_t sampleRight = std::min(right, static_cast<std::ptrdiff_t>(k + (n - i) * s / n + sd));
+            select(elements, sampleLeft, sampleRight, k);
+        }
+
+        std::swap(elements[left], elements[k]);
+        std::ptrdiff_t j = QuickSort<T, Compare, Projection>::partition(elements, left, right);
+        if (j == k)
+            return;
+        if (j < k)
+            left = j + 1;
+        else
+            right = j - 1;
+    }
+}
+
+template <typename T, typename Compare, typename Projection>
+char const * FloydRivestSelect<T, Compare, Projection>::name = "FloydRivest select";
+
+
+// -------------------------------------------------------------------------------
+// ----- PartialSort -----
+//
+
+template <typename T, typename Compare, typename Projection>
+void PartialSort<T, Compare, Projection>::sort(T * array, size_t length, size_t k)
+{
+    if (k >= length)
+    {
+        PdqSort<T, Compare, Projection>::sort(array, length);
+        return;
+    }
+    if (k == 0)
+        return;
+
+    QuickSelect<T, Compare, Projection>::select(array, length, k - 1);
+    PdqSort<T, Compare, Projection>::sort(array, k - 1);
+}
+
+template <typename T, typename Compare, typename Projection>
+char const * PartialSort<T, Compare, Projection>::name = "Partial sort";
+
+
+// -------------------------------------------------------------------------------
+// ----- TopK -----
+//
+
+template <typename T, typename Compare, typename Projection>
+void TopK<T, Compare, Projection>::push(const T & value)
+{
+    if (heap_.size() < k_)
+    {
+        heap_.push_back(value);
+        siftUp_(heap_.size() - 1);
+    }
+    else if (k_ > 0 && less<T, Compare, Projection>(value, heap_.front()))
+    {
+        heap_.front() = value;
+        siftDown_(0);
+    }
+}
+
+template <typename T, typename Compare, typename Projection>
+std::vector<T> TopK<T, Compare, Projection>::sorted() const
+{
+    std::vector<T> elements = heap_;
+    PdqSort<T, Compare, Projection>::sort(elements);
+    return elements;
+}
+
+template <typename T, typename Compare, typename Projection>
+void TopK<T, Compare, Projection>::siftUp_(size_t pos)
+{
+    while (pos > 0)
+    {
+        size_t parent = (pos - 1) / 2;
+        if (!less<T, Compare, Projection>(heap_[parent], heap_[pos]))
+            break;
+        std::swap(heap_[parent], heap_[pos]);
+        pos = parent;
+    }
+}
+
+template <typename T, typename Compare, typename Projection>
+void TopK<T, Compare, Projection>::siftDown_(size_t pos)
+{
+    const size_t length = heap_.size();
+    while (2 * pos + 1 < length)
+    {
+        size_t j = 2 * pos + 1;
+        if (j + 1 < length && less<T, Compare, Projection>(heap_[j], heap_[j + 1]))
+            j++;
+
+        if (!less<T, Compare, Projection>(heap_[pos], heap_[j]))
+            break;
+        std::swap(heap_[pos], heap_[j]);
+        pos = j;
+    }
+}
+
+
+// -------------------------------------------------------------------------------
+// ----- LsdRadixSort -----
+//
+
+template <typename T>
+void LsdRadixSort<T>::sort(T * array, size_t length, tools::TaskPool * pool)
+{
+    if (length < 2)
+        return;
+
+    const size_t chunks = pool != nullptr && length >= MIN_PARALLEL ? pool->threads() + 1 : 1;
+    auto forChunks = [pool, chunks](const std::function<void(size_t)> & f)
+    {
+        if (chunks == 1)
+        {
+            f(0);
+            return;
+        }
+        std::vector<std::function<void()>> tasks;
+        for (size_t c = 0; c < chunks; ++c)
+            tasks.push_back([&f, c]() { f(c); });
+        pool->run(tasks);
+    };
+
+    std::vector<T> aux(length);
+    std::vector<size_t> counts(chunks * RADIX);
+    T * src = array;
+    T * dst = aux.data();
+
+    for (size_t shift = 0; shift < sizeof(typename RadixKey<T>::Type) * 8; shift += 8)
+    {
+        // 1. count bytes of every chunk
+        std::fill(counts.begin(), counts.end(), 0);
+        forChunks([&](size_t c)
+        {
+            size_t * count = &counts[c * RADIX];
+            for (size_t i = length * c / chunks; i < length * (c + 1) / chunks; ++i)
+                ++count[(RadixKey<T>::get(src[i]) >> shift) & (RADIX - 1)];
+        });
+
+        // 2. offsets of the chunk buckets: bucket by bucket, chunk by chunk inside the bucket
+        size_t offset = 0;
+        bool same = false;
+        for (size_t b = 0; b < RADIX; ++b)
+        {
+            size_t bucketStart = offset;
+            for (size_t c = 0; c < chunks; ++c)
+            {
+                size_t count = counts[c * RADIX + b];
+                counts[c * RADIX + b] = offset;
+                offset += count;
+            }
+            same = same || offset - bucketStart == length;
+        }
+        if (same)
+            continue;
+
+        // 3. scatter
+        forChunks([&](size_t c)
+        {
+            size_t * next = &counts[c * RADIX];
+            for (size_t i = length * c / chunks; i < length * (c + 1) / chunks; ++i)
+                dst[next[(RadixKey<T>::get(src[i]) >> shift) & (RADIX - 1)]++] = src[i];
+        });
+        std::swap(src, dst);
+    }
+
+    if (src != array)
+        std::copy(src, src + length, array);
+}
+
+template <typename T>
+char const * LsdRadixSort<T>::name = "LsdRadix sort";
+
+
+// -------------------------------------------------------------------------------
+// ----- MsdRadixSort -----
+//
+
+template <typename T>
+void MsdRadixSort<T>::sort(T * array, size_t length)
+{
+    std::vector<T> aux(length);
+    sort(array, aux, 0, length, 0);
+}
+
+template <typename T>
+void MsdRadixSort<T>::sort(T * elements, std::vector<T> & aux, size_t lo, size_t hi, size_t d)
+{
+    if (hi - lo <= INSERTION_CUTOFF)
+    {
+        insertionSort(elements, lo, hi, d);
+        return;
+    }
+
+    // bucket 0 is for the strings which end before d, bucket c + 1 is for character c
+    size_t count[RADIX + 2] = {};
+    for (size_t i = lo; i < hi; ++i)
+        ++count[charAt(elements[i], d) + 2];
+
+    for (size_t r = 0; r < RADIX + 1; ++r)
+        count[r + 1] += count[r];
+
+    for (size_t i = lo; i < hi; ++i)
+        aux[count[charAt(elements[i], d) + 1]++] = std::move(elements[i]);
+
+    for (size_t i = lo; i < hi; ++i)
+        elements[i] = std::move(aux[i - lo]);
+
+    // now count[r] is the start of the character r bucket
+    for (size_t r = 0; r < RADIX; ++r)
+    {
+        if (count[r + 1] - count[r] > 1)
+            sort(elements, aux, lo + count[r], lo + count[r + 1], d + 1);
+    }
+}
+
+template <typename T>
+void MsdRadixSort<T>::insertionSort(T * elements, size_t lo, size_t hi, size_t d)
+{
+    // strings of the range have the same first d characters, so only the rest is compared
+    for (size_t i = lo + 1; i < hi; ++i)
+    {
+        for (size_t j = i; j > lo && elements[j].compare(d, T::npos, elements[j - 1], d, T::npos) < 0; --j)
+        {
+            std::swap(elements[j], elements[j - 1]);
+        }
+    }
+}
+
+template <typename T>
+char const * MsdRadixSort<T>::name = "MsdRadix sort";
+
+
+// -------------------------------------------------------------------------------
+// ----- AmericanFlagSort -----
+//
+
+template <typename T>
+void AmericanFlagSort<T>::sort(T * array, size_t length)
+{
+    sort(array, 0, length, (sizeof(typename RadixKey<T>::Type) - 1) * 8);
+}
+
+template <typename T>
+void AmericanFlagSort<T>::sort(T * elements, size_t lo, size_t hi, size_t shift)
+{
+    if (hi - lo <= INSERTION_CUTOFF)
+    {
+        if (hi - lo > 1)
+            InsertionSort<T>{}.sort(elements + lo, hi - lo);
+        return;
+    }
+
+    size_t start[RADIX + 1] = {};
+    for (size_t i = lo; i < hi; ++i)
+        ++start[digit(elements[i], shift) + 1];
+
+    start[0] = lo;
+    for (size_t b = 0; b < RADIX; ++b)
+        start[b + 1] += start[b];
+
+    // every element is swapped directly into the next free place of its bucket
+    size_t next[RADIX];
+    std::copy(start, start + RADIX, next);
+    for (size_t b = 0; b < RADIX; ++b)
+    {
+        while (next[b] < start[b + 1])
+        {
+            size_t d = digit(elements[next[b]], shift);
+            if (d == b)
+                ++next[b];
+            else
+                std::swap(elements[next[b]], elements[next[d]++]);
+        }
+    }
+
+    if (shift == 0)
+        return;
+
+    for (size_t b = 0; b < RADIX; ++b)
+    {
+        if (start[b + 1] - start[b] > 1)
+            sort(elements, start[b], start[b + 1], shift - 8);
     }
 }
 
 template <typename T>
-char const * InsertionBinarySort<T>::name = "InsertionBinary sort";
+char const * AmericanFlagSort<T>::name = "AmericanFlag sort";
 
 
 } // namespace sort
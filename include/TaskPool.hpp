@@ -0,0 +1,109 @@
+/**
+ * @author Volodymyr Lotoshko (vlotoshko@gmail.com)
+ * @date 19-Oct-2026
+ */
+
+//--------------------------------------------------------------------------------------------------
+#ifndef TASK_POOL_HPP
+#define TASK_POOL_HPP
+//--------------------------------------------------------------------------------------------------
+
+//--------------------------------------------------------------------------------------------------
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+//--------------------------------------------------------------------------------------------------
+
+namespace tools
+{
+
+/**
+ * @class TaskPool
+ * @brief The TaskPool class is the pool of threads which runs fork-join tasks with work stealing.
+ *
+ * Every worker has its own deque of tasks: it takes the newest task from the back of its deque,
+ * and when the deque is empty it steals the oldest task from the front of another deque. Old
+ * tasks are usually the biggest parts of the divide-and-conquer work, so few steals are needed.
+ * A thread which waits for its tasks in run() executes tasks too instead of blocking, so tasks
+ * may fork and wait for other tasks at any depth. Workers which find no task sleep on the
+ * condition variable until new tasks are queued.
+ */
+class TaskPool
+{
+public:
+    /**
+     * @brief The TaskPool constructor starts the worker threads.
+     * @param[in] threads count of the workers, by default one less than hardware threads,
+     * because the thread which calls run() works too
+     */
+    explicit TaskPool(size_t threads = defaultThreads());
+    ~TaskPool();
+
+    TaskPool(const TaskPool &) = delete;
+    TaskPool & operator= (const TaskPool &) = delete;
+
+    /**
+     * @brief Runs the tasks in parallel and returns when all of them are done.
+     * @param[in] tasks tasks to run, the first one is run by the calling thread
+     * @throws the first exception thrown by the tasks, it is rethrown after all of them are done
+     */
+    void run(const std::vector<std::function<void()>> & tasks);
+
+    /// @brief Runs two tasks in parallel and returns when both are done.
+    void run(const std::function<void()> & a, const std::function<void()> & b) { run({a, b}); }
+
+    /// @brief Returns count of the worker threads.
+    size_t threads() const { return workers_.size(); }
+
+    /// @brief Returns the pool shared by the sort algorithms.
+    static TaskPool & instance();
+
+    /// @brief Returns count of hardware threads minus one.
+    static size_t defaultThreads();
+
+private:
+    /// @brief Deque of tasks guarded by its own mutex
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    /// @brief Tasks of one run() call: count of unfinished tasks and the first exception
+    struct Batch
+    {
+        std::atomic<size_t> pending;
+        std::mutex mutex;
+        std::exception_ptr error;
+
+        /// @brief Runs the task and keeps its exception, the task is not counted in pending
+        void execute(const std::function<void()> & task);
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues_; // one per worker and the last one for the others
+    std::vector<std::thread> workers_;
+    std::atomic<bool> stop_;
+    std::atomic<size_t> queued_;                 // count of tasks in all queues
+    std::mutex sleepMutex_;
+    std::condition_variable wakeUp_;
+
+    /// @brief Returns index of the queue of the calling thread
+    size_t self_() const;
+
+    /// @brief Runs one task taken from own queue or stolen from other queues
+    bool runOne_(size_t self);
+
+    void work_(size_t self);
+};
+
+} // namespace tools
+
+//--------------------------------------------------------------------------------------------------
+#endif // TASK_POOL_HPP
+//--------------------------------------------------------------------------------------------------
@@ -13,6 +13,7 @@
 #include <vector>
 #include <iostream>
 #include <random>
+#include <string>
 //--------------------------------------------------------------------------------------------------
 
 namespace tools
@@ -139,6 +140,14 @@ private:
     double previous_;
 };
 
+/**
+ * @brief temporaryFile creates the empty file with the unique name in the temporary directory
+ * (TMPDIR or /tmp), the caller removes it.
+ * @param[in] prefix prefix of the file name
+ * @return name of the file
+ * @throws std::runtime_error if the file can not be created
+ */
+std::string temporaryFile(const std::string & prefix);
 
 } // namespace tools
 
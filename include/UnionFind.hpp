@@ -9,6 +9,11 @@
 // -------------------------------------------------------------------------------------------------
 
 // -------------------------------------------------------------------------------------------------
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <string>
 // -------------------------------------------------------------------------------------------------
@@ -220,6 +225,191 @@ private:
 
 
 
+/**
+ * @struct UnionFindCompactInfo
+ * @brief The UnionFindCompactInfo template struct holds information how elements are connected
+ * one with other using a single word per element.
+ * @tparam T unsigned type of the element, 32-bit by default
+ *
+ * Non-negative word is the parent of the element, negative word marks the root of the claster
+ * and holds the negated size of the claster. Up to 2^31 - 1 elements are supported for
+ * the 32-bit element type.
+ */
+template<typename T = uint32_t>
+struct UnionFindCompactInfo
+{
+    static_assert(std::is_unsigned<T>::value, "UnionFindCompactInfo requires unsigned type");
+
+    /// signed word which packs parent or negated claster size
+    using Word = typename std::make_signed<T>::type;
+
+    /**
+     * @brief The UnionFindCompactInfo constructor inits data with initial values.
+     * @param[in] count count of the elements
+     * @throws std::length_error if count does not fit into the positive range of Word
+     */
+    explicit UnionFindCompactInfo(const size_t & count);
+
+    /// parents of the elements or negated sizes of the clasters for roots
+    std::vector<Word> elements;
+
+    /// count of the claster in the elements
+    T clasters;
+};
+
+
+/**
+ * @class UnionFind_Compact
+ * @brief The UnionFind_Compact template class implements 'quick union' strategy balanced
+ * by size with path halving over the UnionFindCompactInfo packed array.
+ * @tparam T unsigned type of the element, 32-bit by default
+ */
+template <typename T = uint32_t>
+class UnionFind_Compact
+{
+public:
+    /// class name
+    static char const * name;
+
+    /**
+     * @brief Unions two clusters of given components into one if they were not connected before.
+     * Decreases clasters count by 1.
+     * @param[out] ufData UnionFindCompactInfo structure to union
+     * @param[in] p component 1 of the UnionFindCompactInfo structure
+     * @param[in] q component 2 of the UnionFindCompactInfo structure
+     * @returns true if not connected components become connected.
+     *
+     * The root of the smaller claster is linked under the root of the bigger one.
+     */
+    bool unionComponents(UnionFindCompactInfo<T> & ufData, T p, T q);
+
+    /**
+     * @brief Finds claster ID of a given component, halving the path to the root on the way.
+     * @param[out] ufData UnionFindCompactInfo structure to search in
+     * @param[in] p component of the UnionFindCompactInfo structure
+     * @returns claster ID of a given component.
+     */
+    T find(UnionFindCompactInfo<T> & ufData, T p);
+
+    /**
+     * @brief Checks whether two components belongs to the same claster, i.e. connected.
+     * @param[out] ufData UnionFindCompactInfo structure to check connection
+     * @param[in] p component 1 of the UnionFindCompactInfo structure
+     * @param[in] q component 2 of the UnionFindCompactInfo structure
+     * @returns true if components are connected.
+     */
+    bool connected(UnionFindCompactInfo<T> & ufData, T p, T q) { return find(ufData, p) == find(ufData, q); }
+
+    /**
+     * @brief Returns size of the claster to which belongs the given component.
+     * @param[out] ufData UnionFindCompactInfo structure to search in
+     * @param[in] p component of the UnionFindCompactInfo structure
+     * @returns size of the claster.
+     */
+    T clasterSize(UnionFindCompactInfo<T> & ufData, T p) { return static_cast<T>(-ufData.elements[find(ufData, p)]); }
+};
+
+
+/**
+ * @struct UnionFindRollbackInfo
+ * @brief The UnionFindRollbackInfo template struct holds information how elements are
+ * connected one with other and the log of unions which can be undone.
+ * @tparam T type of the element
+ */
+template<typename T>
+struct UnionFindRollbackInfo
+{
+    /**
+     * @brief The UnionFindRollbackInfo constructor inits data with initial values.
+     * @param[in] count count of the elements
+     */
+    explicit UnionFindRollbackInfo(const size_t & count);
+
+    /// information about elements connections
+    std::vector<T> elements;
+
+    /// upper bounds of the heights of the clasters' trees
+    std::vector<unsigned char> ranks;
+
+    /// count of the claster in the elements
+    size_t clasters;
+
+    /// one record of the unions log
+    struct Record
+    {
+        /// root which was linked under other root
+        T child;
+        /// true if the rank of the new root was increased
+        bool rankIncreased;
+    };
+
+    /// log of the unions in order they were made
+    std::vector<Record> history;
+};
+
+
+/**
+ * @class UnionFind_Rollback
+ * @brief The UnionFind_Rollback template class implements 'quick union' strategy balanced
+ * by rank without path compression, so every union can be undone.
+ * @tparam T type of the element
+ *
+ * Trees are never restructured by find, so rolling back the last union is just unlinking one
+ * root. Find takes O(log n) as union by rank keeps trees logarithmic.
+ */
+template <typename T>
+class UnionFind_Rollback
+{
+public:
+    /// class name
+    static char const * name;
+
+    /**
+     * @brief Unions two clusters of given components into one if they were not connected before.
+     * Decreases clasters count by 1 and logs the union.
+     * @param[out] ufData UnionFindRollbackInfo structure to union
+     * @param[in] p component 1 of the UnionFindRollbackInfo structure
+     * @param[in] q component 2 of the UnionFindRollbackInfo structure
+     * @returns true if not connected components become connected.
+     */
+    bool unionComponents(UnionFindRollbackInfo<T> & ufData, const T & p, const T & q);
+
+    /**
+     * @brief Finds claster ID of a given component.
+     * @param[in] ufData UnionFindRollbackInfo structure to search in
+     * @param[in] p component of the UnionFindRollbackInfo structure
+     * @returns claster ID of a given component.
+     */
+    T find(const UnionFindRollbackInfo<T> & ufData, T p) const;
+
+    /**
+     * @brief Checks whether two components belongs to the same claster, i.e. connected.
+     * @param[in] ufData UnionFindRollbackInfo structure to check connection
+     * @param[in] p component 1 of the UnionFindRollbackInfo structure
+     * @param[in] q component 2 of the UnionFindRollbackInfo structure
+     * @returns true if components are connected.
+     */
+    bool connected(const UnionFindRollbackInfo<T> & ufData, const T & p, const T & q) const
+    {
+        return find(ufData, p) == find(ufData, q);
+    }
+
+    /**
+     * @brief Remembers the current state of the structure.
+     * @param[in] ufData UnionFindRollbackInfo structure
+     * @returns checkpoint which can be passed to rollback.
+     */
+    size_t checkpoint(const UnionFindRollbackInfo<T> & ufData) const { return ufData.history.size(); }
+
+    /**
+     * @brief Undoes all unions made after the given checkpoint.
+     * @param[out] ufData UnionFindRollbackInfo structure
+     * @param[in] checkpoint value returned by checkpoint
+     */
+    void rollback(UnionFindRollbackInfo<T> & ufData, size_t checkpoint);
+};
+
+
 // -------------------------------------------------------------------------------
 // ---------------- Template classes definitions ---------------------------------
 // -------------------------------------------------------------------------------
@@ -337,6 +527,145 @@ T UnionFind_QuickUnion_Balanced<T>::find_(const UnionFindInfo<T> & ufData, T p)
 template <typename T>
 char const * UnionFind_QuickUnion_Balanced<T>::name = "UnionFind/QiuckUnion balanced";
 
+
+
+// -------------------------------------------------------------------------------
+// ----- UnionFindCompactInfo -----
+//
+
+template <typename T>
+UnionFindCompactInfo<T>::UnionFindCompactInfo(const size_t & count)
+    : elements(), clasters(static_cast<T>(count))
+{
+    if (count > static_cast<size_t>(std::numeric_limits<Word>::max()))
+    {
+        throw std::length_error("UnionFindCompactInfo: too many elements");
+    }
+    elements.assign(count, Word{-1});
+}
+
+
+// -------------------------------------------------------------------------------
+// ----- UnionFind_Compact -----
+//
+
+template <typename T>
+bool UnionFind_Compact<T>::unionComponents(UnionFindCompactInfo<T> & ufData, T p, T q)
+{
+    auto pId = find(ufData, p);
+    auto qId = find(ufData, q);
+    if (pId == qId)
+    {
+        return false;
+    }
+
+    // sizes are negated, so the bigger claster has the smaller root word
+    if (ufData.elements[pId] > ufData.elements[qId])
+    {
+        std::swap(pId, qId);
+    }
+    ufData.elements[pId] += ufData.elements[qId];
+    ufData.elements[qId] = static_cast<typename UnionFindCompactInfo<T>::Word>(pId);
+    --ufData.clasters;
+    return true;
+}
+
+template <typename T>
+T UnionFind_Compact<T>::find(UnionFindCompactInfo<T> & ufData, T p)
+{
+    auto & elements = ufData.elements;
+    while (elements[p] >= 0)
+    {
+        auto parent = elements[p];
+        if (elements[parent] >= 0)
+        {
+            elements[p] = elements[parent];
+        }
+        p = static_cast<T>(elements[p]);
+    }
+    return p;
+}
+
+template <typename T>
+char const * UnionFind_Compact<T>::name = "UnionFind/Compact";
+
+
+
+// -------------------------------------------------------------------------------
+// ----- UnionFindRollbackInfo -----
+//
+
+template <typename T>
+UnionFindRollbackInfo<T>::UnionFindRollbackInfo(const size_t & count)
+    : elements(count), ranks(count, 0), clasters(count), history()
+{
+    T inc = 0;
+    for (auto & item : elements)
+    {
+        item = inc++;
+    }
+}
+
+
+// -------------------------------------------------------------------------------
+// ----- UnionFind_Rollback -----
+//
+
+template <typename T>
+bool UnionFind_Rollback<T>::unionComponents(UnionFindRollbackInfo<T> & ufData, const T & p, const T & q)
+{
+    auto pId = find(ufData, p);
+    auto qId = find(ufData, q);
+    if (pId == qId)
+    {
+        return false;
+    }
+
+    if (ufData.ranks[pId] < ufData.ranks[qId])
+    {
+        std::swap(pId, qId);
+    }
+    bool rankIncreased = ufData.ranks[pId] == ufData.ranks[qId];
+    ufData.elements[qId] = pId;
+    if (rankIncreased)
+    {
+        ++ufData.ranks[pId];
+    }
+    --ufData.clasters;
+    ufData.history.push_back({qId, rankIncreased});
+    return true;
+}
+
+template <typename T>
+T UnionFind_Rollback<T>::find(const UnionFindRollbackInfo<T> & ufData, T p) const
+{
+    while (p != ufData.elements[p])
+    {
+        p = ufData.elements[p];
+    }
+    return p;
+}
+
+template <typename T>
+void UnionFind_Rollback<T>::rollback(UnionFindRollbackInfo<T> & ufData, size_t checkpoint)
+{
+    while (ufData.history.size() > checkpoint)
+    {
+        auto const & record = ufData.history.back();
+        auto & parent = ufData.elements[record.child];
+        if (record.rankIncreased)
+        {
+            --ufData.ranks[parent];
+        }
+        parent = record.child;
+        ++ufData.clasters;
+        ufData.history.pop_back();
+    }
+}
+
+template <typename T>
+char const * UnionFind_Rollback<T>::name = "UnionFind/Rollback";
+
 } // namespace unionfind
 
 // -------------------------------------------------------------------------------------------------
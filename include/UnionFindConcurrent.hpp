@@ -0,0 +1,207 @@
+/**
+ * @author Volodymyr Lotoshko (vlotoshko@gmail.com)
+ * @date 19-Oct-2026
+ */
+
+// -------------------------------------------------------------------------------------------------
+#ifndef UNIONFIND_CONCURRENT_HPP
+#define UNIONFIND_CONCURRENT_HPP
+// -------------------------------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------------------------
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <random>
+#include <vector>
+// -------------------------------------------------------------------------------------------------
+
+namespace uf
+{
+
+/**
+ * @struct UnionFindConcurrentInfo
+ * @brief The UnionFindConcurrentInfo template struct holds information how elements are
+ * connected one with other and can be shared between threads.
+ * @tparam T type of the element
+ *
+ * Every element has a random priority. A root with the lower priority is always linked under
+ * a root with the higher priority, so trees stay shallow (expected O(log n) height) without
+ * the need to keep sizes in sync between threads.
+ */
+template<typename T>
+struct UnionFindConcurrentInfo
+{
+    /**
+     * @brief The UnionFindConcurrentInfo constructor inits data with initial values.
+     * @param[in] count count of the elements
+     * @param[in] seed seed for the priorities generator
+     */
+    explicit UnionFindConcurrentInfo(const size_t & count, unsigned seed = std::random_device()());
+
+    UnionFindConcurrentInfo(const UnionFindConcurrentInfo &) = delete;
+    UnionFindConcurrentInfo & operator= (const UnionFindConcurrentInfo &) = delete;
+
+    /// information about elements connections
+    std::vector<std::atomic<T>> elements;
+
+    /// random link priorities of the elements
+    std::vector<T> priorities;
+
+    /// count of the claster in the elements
+    std::atomic<size_t> clasters;
+};
+
+
+/**
+ * @class UnionFind_Concurrent
+ * @brief The UnionFind_Concurrent template class implements lock-free 'quick union' strategy
+ * which can be used by many threads at once.
+ * @tparam T type of the element
+ *
+ * Roots are linked with a single compare-and-swap, find compresses paths by halving with
+ * compare-and-swap as well. Failed CAS means other thread has changed the tree in the meantime,
+ * so the operation is retried from the new roots.
+ */
+template <typename T>
+class UnionFind_Concurrent
+{
+public:
+    /// class name
+    static char const * name;
+
+    /**
+     * @brief Unions two clusters of given components into one if they were not connected before.
+     * Decreases clasters count by 1.
+     * @param[out] ufData UnionFindConcurrentInfo structure to union
+     * @param[in] p component 1 of the UnionFindConcurrentInfo structure
+     * @param[in] q component 2 of the UnionFindConcurrentInfo structure
+     * @returns true if not connected components become connected.
+     */
+    bool unionComponents(UnionFindConcurrentInfo<T> & ufData, T p, T q);
+
+    /**
+     * @brief Finds claster ID of a given component.
+     * @param[in] ufData UnionFindConcurrentInfo structure to search in
+     * @param[in] p component of the UnionFindConcurrentInfo structure
+     * @returns claster ID of a given component.
+     *
+     * The returned ID may become outdated right after return if other threads union clusters.
+     */
+    T find(UnionFindConcurrentInfo<T> & ufData, T p);
+
+    /**
+     * @brief Checks whether two components belongs to the same claster, i.e. connected.
+     * @param[in] ufData UnionFindConcurrentInfo structure to check connection
+     * @param[in] p component 1 of the UnionFindConcurrentInfo structure
+     * @param[in] q component 2 of the UnionFindConcurrentInfo structure
+     * @returns true if components are connected.
+     */
+    bool connected(UnionFindConcurrentInfo<T> & ufData, T p, T q);
+};
+
+
+
+// -------------------------------------------------------------------------------
+// ---------------- Template classes definitions ---------------------------------
+// -------------------------------------------------------------------------------
+
+// -------------------------------------------------------------------------------
+// ----- UnionFindConcurrentInfo -----
+//
+
+template <typename T>
+UnionFindConcurrentInfo<T>::UnionFindConcurrentInfo(const size_t & count, unsigned seed)
+    : elements(count), priorities(count), clasters(count)
+{
+    T inc = 0;
+    for (auto & item : elements)
+    {
+        item.store(inc++, std::memory_order_relaxed);
+    }
+
+    std::iota(priorities.begin(), priorities.end(), T{0});
+    std::shuffle(priorities.begin(), priorities.end(), std::mt19937(seed));
+}
+
+
+// -------------------------------------------------------------------------------
+// ----- UnionFind_Concurrent -----
+//
+
+template <typename T>
+bool UnionFind_Concurrent<T>::unionComponents(UnionFindConcurrentInfo<T> & ufData, T p, T q)
+{
+    while (true)
+    {
+        p = find(ufData, p);
+        q = find(ufData, q);
+        if (p == q)
+        {
+            return false;
+        }
+
+        if (ufData.priorities[p] < ufData.priorities[q])
+        {
+            std::swap(p, q);
+        }
+
+        // q is linked under p only if q is still a root
+        T expected = q;
+        if (ufData.elements[q].compare_exchange_strong(expected, p, std::memory_order_acq_rel))
+        {
+            ufData.clasters.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+}
+
+template <typename T>
+T UnionFind_Concurrent<T>::find(UnionFindConcurrentInfo<T> & ufData, T p)
+{
+    while (true)
+    {
+        T parent = ufData.elements[p].load(std::memory_order_acquire);
+        if (parent == p)
+        {
+            return p;
+        }
+
+        T grand = ufData.elements[parent].load(std::memory_order_acquire);
+        if (parent != grand)
+        {
+            // path halving, it is fine to lose this race
+            ufData.elements[p].compare_exchange_weak(parent, grand, std::memory_order_acq_rel);
+        }
+        p = grand;
+    }
+}
+
+template <typename T>
+bool UnionFind_Concurrent<T>::connected(UnionFindConcurrentInfo<T> & ufData, T p, T q)
+{
+    while (true)
+    {
+        p = find(ufData, p);
+        q = find(ufData, q);
+        if (p == q)
+        {
+            return true;
+        }
+
+        // p is still a root, so the components were not connected at the moment of the check
+        if (ufData.elements[p].load(std::memory_order_acquire) == p)
+        {
+            return false;
+        }
+    }
+}
+
+template <typename T>
+char const * UnionFind_Concurrent<T>::name = "UnionFind/Concurrent";
+
+} // namespace uf
+
+// -------------------------------------------------------------------------------------------------
+#endif // UNIONFIND_CONCURRENT_HPP
+// -------------------------------------------------------------------------------------------------
@@ -0,0 +1,134 @@
+/**
+ * @author Volodymyr Lotoshko (vlotoshko@gmail.com)
+ * @date 19-Oct-2026
+ */
+
+// -------------------------------------------------------------------------------------------------
+#include "DynamicConnectivity.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+// -------------------------------------------------------------------------------------------------
+
+namespace graph
+{
+
+//--------------------------------------------------------------------------------------------------
+// ------- OfflineDynamicConnectivity -------------------------------------------------
+//
+
+OfflineDynamicConnectivity::OfflineDynamicConnectivity(size_t v)
+    : v_(v), time_(0), alive_(), closed_(), queries_()
+{
+}
+
+size_t OfflineDynamicConnectivity::addEdge(size_t v, size_t w)
+{
+    alive_[std::minmax(v, w)].push_back(++time_);
+    return time_;
+}
+
+size_t OfflineDynamicConnectivity::removeEdge(size_t v, size_t w)
+{
+    auto it = alive_.find(std::minmax(v, w));
+    if (it == alive_.end())
+    {
+        throw std::invalid_argument("OfflineDynamicConnectivity: removing absent edge");
+    }
+
+    // the edge is still present at the current time and disappears at the next one
+    closed_.push_back({it->second.back(), time_, v, w});
+    it->second.pop_back();
+    if (it->second.empty())
+    {
+        alive_.erase(it);
+    }
+    return ++time_;
+}
+
+size_t OfflineDynamicConnectivity::query(size_t v, size_t w, size_t t)
+{
+    queries_.push_back({v, w, t});
+    return queries_.size() - 1;
+}
+
+std::vector<bool> OfflineDynamicConnectivity::solve() const
+{
+    std::vector<bool> answers(queries_.size(), false);
+    std::vector<std::vector<size_t>> queriesAt(time_ + 1);
+    for (size_t i = 0; i < queries_.size(); ++i)
+    {
+        if (queries_[i].t > time_)
+        {
+            throw std::out_of_range("OfflineDynamicConnectivity: query after the last event");
+        }
+        queriesAt[queries_[i].t].push_back(i);
+    }
+
+    SegmentTree tree(4 * (time_ + 1));
+    for (auto const & edge : closed_)
+    {
+        insert(tree, 1, 0, time_, edge);
+    }
+    for (auto const & item : alive_)
+    {
+        for (auto const & from : item.second)
+        {
+            insert(tree, 1, 0, time_, {from, time_, item.first.first, item.first.second});
+        }
+    }
+
+    uf::UnionFindRollbackInfo<size_t> ufData(v_);
+    traverse(tree, 1, 0, time_, queriesAt, ufData, answers);
+    return answers;
+}
+
+void OfflineDynamicConnectivity::insert(SegmentTree & tree, size_t node, size_t lo, size_t hi,
+                                        const Interval & edge) const
+{
+    if (edge.to < lo || hi < edge.from)
+    {
+        return;
+    }
+    if (edge.from <= lo && hi <= edge.to)
+    {
+        tree[node].emplace_back(edge.v, edge.w);
+        return;
+    }
+
+    size_t mid = lo + (hi - lo) / 2;
+    insert(tree, 2 * node, lo, mid, edge);
+    insert(tree, 2 * node + 1, mid + 1, hi, edge);
+}
+
+void OfflineDynamicConnectivity::traverse(const SegmentTree & tree, size_t node, size_t lo, size_t hi,
+                                          const std::vector<std::vector<size_t>> & queriesAt,
+                                          uf::UnionFindRollbackInfo<size_t> & ufData,
+                                          std::vector<bool> & answers) const
+{
+    uf::UnionFind_Rollback<size_t> unionFind;
+    size_t checkpoint = unionFind.checkpoint(ufData);
+    for (auto const & edge : tree[node])
+    {
+        unionFind.unionComponents(ufData, edge.first, edge.second);
+    }
+
+    if (lo == hi)
+    {
+        for (auto const & i : queriesAt[lo])
+        {
+            answers[i] = unionFind.connected(ufData, queries_[i].v, queries_[i].w);
+        }
+    }
+    else
+    {
+        size_t mid = lo + (hi - lo) / 2;
+        traverse(tree, 2 * node, lo, mid, queriesAt, ufData, answers);
+        traverse(tree, 2 * node + 1, mid + 1, hi, queriesAt, ufData, answers);
+    }
+
+    unionFind.rollback(ufData, checkpoint);
+}
+
+} // namespace graph
+//--------------------------------------------------------------------------------------------------
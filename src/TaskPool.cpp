@@ -0,0 +1,198 @@
+/**
+ * @author Volodymyr Lotoshko (vlotoshko@gmail.com)
+ * @date 19-Oct-2026
+ */
+
+//--------------------------------------------------------------------------------------------------
+#include "TaskPool.hpp"
+//--------------------------------------------------------------------------------------------------
+
+namespace tools
+{
+
+namespace
+{
+
+/// pool and queue index of the current worker thread
+thread_local const TaskPool * currentPool = nullptr;
+thread_local size_t currentQueue = 0;
+
+/// count of spins of the idle worker before it goes to sleep
+const size_t SPINS_BEFORE_SLEEP = 64;
+
+/// @brief Decrements the counter when the scope is left
+struct Done
+{
+    std::atomic<size_t> & counter;
+    ~Done() { --counter; }
+};
+
+} // namespace
+
+TaskPool::TaskPool(size_t threads)
+    : queues_(), workers_(), stop_(false), queued_(0), sleepMutex_(), wakeUp_()
+{
+    for (size_t i = 0; i <= threads; ++i)
+    {
+        queues_.emplace_back(new Queue);
+    }
+    for (size_t i = 0; i < threads; ++i)
+    {
+        workers_.emplace_back(&TaskPool::work_, this, i);
+    }
+}
+
+TaskPool::~TaskPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stop_ = true;
+    }
+    wakeUp_.notify_all();
+    for (auto & worker : workers_)
+    {
+        worker.join();
+    }
+}
+
+void TaskPool::run(const std::vector<std::function<void()>> & tasks)
+{
+    if (tasks.empty())
+    {
+        return;
+    }
+
+    // batch lives on the stack, it is safe because run does not return until all tasks are done,
+    // and queued tasks never throw: the decrement is the last access of a task to the batch
+    Batch batch;
+    batch.pending = tasks.size() - 1;
+    const size_t self = self_();
+    {
+        auto & queue = *queues_[self];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        for (size_t i = tasks.size() - 1; i > 0; --i)
+        {
+            const auto & task = tasks[i];
+            queue.tasks.emplace_back([&task, &batch]()
+            {
+                Done done{batch.pending};
+                batch.execute(task);
+            });
+        }
+        queued_ += tasks.size() - 1;
+    }
+    if (tasks.size() > 1)
+    {
+        // the lock makes sure that a worker which has just seen no tasks is waiting already
+        { std::lock_guard<std::mutex> lock(sleepMutex_); }
+        wakeUp_.notify_all();
+    }
+
+    batch.execute(tasks.front());
+
+    while (batch.pending > 0)
+    {
+        if (!runOne_(self))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    if (batch.error)
+    {
+        std::rethrow_exception(batch.error);
+    }
+}
+
+TaskPool & TaskPool::instance()
+{
+    static TaskPool pool;
+    return pool;
+}
+
+size_t TaskPool::defaultThreads()
+{
+    size_t threads = std::thread::hardware_concurrency();
+    return threads > 1 ? threads - 1 : 1;
+}
+
+void TaskPool::Batch::execute(const std::function<void()> & task)
+{
+    try
+    {
+        task();
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error)
+        {
+            error = std::current_exception();
+        }
+    }
+}
+
+size_t TaskPool::self_() const
+{
+    return currentPool == this ? currentQueue : queues_.size() - 1;
+}
+
+bool TaskPool::runOne_(size_t self)
+{
+    std::function<void()> task;
+    {
+        auto & queue = *queues_[self];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty())
+        {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+    }
+
+    for (size_t i = 1; !task && i < queues_.size(); ++i)
+    {
+        auto & queue = *queues_[(self + i) % queues_.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty())
+        {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+    }
+
+    if (!task)
+    {
+        return false;
+    }
+    --queued_;
+    task();
+    return true;
+}
+
+void TaskPool::work_(size_t self)
+{
+    currentPool = this;
+    currentQueue = self;
+
+    size_t idle = 0;
+    while (!stop_)
+    {
+        if (runOne_(self))
+        {
+            idle = 0;
+        }
+        else if (++idle < SPINS_BEFORE_SLEEP)
+        {
+            std::this_thread::yield();
+        }
+        else
+        {
+            std::unique_lock<std::mutex> lock(sleepMutex_);
+            wakeUp_.wait(lock, [this]() { return stop_ || queued_ > 0; });
+            idle = 0;
+        }
+    }
+}
+
+} // namespace tools
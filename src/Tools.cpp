@@ -6,7 +6,14 @@
 //--------------------------------------------------------------------------------------------------
 #include "Tools.hpp"
 
+#include <cstdio>
+#include <cstdlib>
 #include <iomanip>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
 //--------------------------------------------------------------------------------------------------
 
 namespace tools
@@ -41,6 +48,30 @@ double CalcRatio::getRatio(double value)
     return result;
 }
 
+std::string temporaryFile(const std::string & prefix)
+{
+#ifndef _WIN32
+    const char * tmp = std::getenv("TMPDIR");
+    std::string name = std::string(tmp != nullptr && *tmp != '\0' ? tmp : "/tmp") + "/" + prefix + "_XXXXXX";
+    const int fd = mkstemp(&name[0]);
+    if (fd == -1)
+    {
+        throw std::runtime_error("can not create temporary file " + name);
+    }
+    close(fd);
+#else
+    char * unique = _tempnam(nullptr, prefix.c_str());
+    std::string name = unique != nullptr ? unique : "";
+    std::free(unique);
+    std::FILE * file = name.empty() ? nullptr : std::fopen(name.c_str(), "wb");
+    if (file == nullptr)
+    {
+        throw std::runtime_error("can not create temporary file " + name);
+    }
+    std::fclose(file);
+#endif
+    return name;
+}
 
 } // namespace tools
 //--------------------------------------------------------------------------------------------------
@@ -7,7 +7,13 @@
 #include "catch2/catch.hpp"
 #include "BstUnbalanced.hpp"
 #include "BstRedBlack.hpp"
+#include "BPlusTree.hpp"
+#include "SkipListConcurrent.hpp"
 #include "Tools.hpp"
+
+#include <limits>
+#include <map>
+#include <thread>
 //--------------------------------------------------------------------------------------------------
 
 namespace tests
@@ -192,4 +198,487 @@ SCENARIO( "RedBlack nodes coloring testing", "[bst_rb]" ) {
     }
 }
 
+SCENARIO( "Bst node allocators testing", "[bst]" ) {
+    GIVEN( "Node pool" ) {
+        struct Node { int key; int val; };
+        bst::NodePool<Node> pool;
+
+        WHEN( "Creating and destroying nodes" ) {
+            std::vector<Node *> nodes;
+            for (int i = 0; i < 100; ++i)
+                nodes.push_back(pool.create(Node{i, i * 2}));
+            THEN( "Nodes are allocated in slabs and keep their values" ) {
+                REQUIRE( pool.capacity() == static_cast<size_t>(64 + 128) );
+                for (int i = 0; i < 100; ++i)
+                    REQUIRE( nodes[static_cast<size_t>(i)]->val == i * 2 );
+            }
+            pool.destroy(nodes[10]);
+            THEN( "Memory of the destroyed node is reused" ) {
+                REQUIRE( pool.create(Node{-1, -1}) == nodes[10] );
+                REQUIRE( pool.capacity() == static_cast<size_t>(64 + 128) );
+            }
+            pool.release();
+            THEN( "Release frees all slabs" ) {
+                REQUIRE( pool.capacity() == static_cast<size_t>(0) );
+            }
+        }
+    }
+    GIVEN( "Trees with different node allocators" ) {
+        bst::BinarySearchTree<int, int, bst::NodeHeap> heapTree;
+        bst::BinarySearchTree<int, int, bst::NodePool> poolTree;
+        bst::BstRedBlack<int, int, bst::NodeHeap> heapRbTree;
+        bst::BstRedBlack<int, int> poolRbTree;
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            int k = (i * 7919) % 1000;
+            heapTree.put(k, k);
+            poolTree.put(k, k);
+            heapRbTree.put(k, k);
+            poolRbTree.put(k, k);
+        }
+
+        WHEN( "Deleting and clearing nodes" ) {
+            for (int k = 0; k < 1000; k += 2)
+            {
+                heapTree.deleteNode(k);
+                poolTree.deleteNode(k);
+            }
+            THEN( "Trees contain the same items" ) {
+                REQUIRE( heapTree.size() == static_cast<size_t>(500) );
+                REQUIRE( poolTree.size() == static_cast<size_t>(500) );
+                REQUIRE( heapTree.keys() == poolTree.keys() );
+                REQUIRE( poolRbTree.get(999) == heapRbTree.get(999) );
+            }
+            poolTree.clear();
+            poolRbTree.clear();
+            THEN( "Cleared trees are empty and can be reused" ) {
+                REQUIRE( poolTree.size() == static_cast<size_t>(0) );
+                REQUIRE( poolRbTree.get(1) == 0 );
+                poolTree.put(1, 0);
+                REQUIRE( poolTree.get(1) == 1 );
+            }
+        }
+    }
+}
+
+SCENARIO( "RedBlack deleting and building testing", "[bst_rb]" ) {
+    GIVEN( "BstRedBlack with some items" ) {
+        bst::BstRedBlack<int, int> bstRb;
+        for (int i = 0; i < 500; ++i)
+            bstRb.put((i * 7919) % 500, 0);
+
+        WHEN( "Deleting items by key" ) {
+            for (int k = 0; k < 500; k += 3)
+            {
+                bstRb.deleteNode(k);
+                REQUIRE( bst::testRbIsBalanced(bstRb) );
+            }
+            bstRb.deleteNode(-1);
+            THEN( "Only deleted items are absent" ) {
+                REQUIRE( bstRb.size() == static_cast<size_t>(333) );
+                for (int k = 0; k < 500; ++k)
+                    REQUIRE( bstRb.get(k) == (k % 3 == 0 ? 0 : 1) );
+            }
+        }
+        WHEN( "Deleting minimal and maximal items" ) {
+            for (int i = 0; i < 100; ++i)
+            {
+                bstRb.deleteMin();
+                bstRb.deleteMax();
+                REQUIRE( bst::testRbIsBalanced(bstRb) );
+            }
+            THEN( "Items are deleted from both ends" ) {
+                REQUIRE( bstRb.size() == static_cast<size_t>(300) );
+                REQUIRE( bstRb.get(99) == 0 );
+                REQUIRE( bstRb.get(100) == 1 );
+                REQUIRE( bstRb.get(399) == 1 );
+                REQUIRE( bstRb.get(400) == 0 );
+            }
+        }
+        WHEN( "Deleting all items" ) {
+            for (int k = 0; k < 500; ++k)
+                bstRb.deleteNode(k);
+            bstRb.deleteMin();
+            bstRb.deleteMax();
+            THEN( "Tree is empty" ) {
+                REQUIRE( bstRb.size() == static_cast<size_t>(0) );
+                REQUIRE( bst::testRbIsBalanced(bstRb) );
+            }
+        }
+    }
+    GIVEN( "Sorted items" ) {
+        bst::BstRedBlack<int, int> bstRb;
+
+        WHEN( "Building trees of different sizes" ) {
+            THEN( "Trees are balanced and contain all items" ) {
+                for (int n = 0; n < 300; ++n)
+                {
+                    std::vector<std::pair<int, int>> items;
+                    for (int i = 0; i < n; ++i)
+                        items.emplace_back(i * 2, i);
+                    bstRb.build(items.begin(), items.end());
+                    REQUIRE( bst::testRbIsBalanced(bstRb) );
+                    REQUIRE( bstRb.size() == static_cast<size_t>(n) );
+                    for (int i = 0; i < n; ++i)
+                        REQUIRE( bstRb.get(i * 2) == i );
+                }
+            }
+        }
+        WHEN( "Modifying the built tree" ) {
+            std::vector<std::pair<int, int>> items;
+            for (int i = 0; i < 1000; ++i)
+                items.emplace_back(i, 0);
+            bstRb.build(items.begin(), items.end());
+            for (int i = 0; i < 1000; i += 2)
+                bstRb.deleteNode(i);
+            for (int i = 1000; i < 1100; ++i)
+                bstRb.put(i, 0);
+            THEN( "Tree stays balanced" ) {
+                REQUIRE( bst::testRbIsBalanced(bstRb) );
+                REQUIRE( bstRb.size() == static_cast<size_t>(600) );
+            }
+        }
+        WHEN( "Building from unsorted items" ) {
+            std::vector<std::pair<int, int>> items = { {1, 0}, {1, 0} };
+            THEN( "Exception is thrown" ) {
+                REQUIRE_THROWS_AS( bstRb.build(items.begin(), items.end()), std::invalid_argument );
+            }
+        }
+    }
+}
+
+SCENARIO( "BPlusTree testing", "[bst_bplus]" ) {
+    GIVEN( "BPlusTree of small order and the map with the same items" ) {
+        bst::BPlusTree<int, int, 4> tree;
+        std::map<int, int> map;
+        for (int i = 0; i < 2000; ++i)
+        {
+            int k = (i * 7919) % 1500 * 2;
+            tree.put(k, i);
+            map[k] = i;
+        }
+
+        WHEN( "Getting items" ) {
+            THEN( "Values are the same as in the map" ) {
+                REQUIRE( tree.size() == map.size() );
+                REQUIRE( tree.height() > static_cast<size_t>(4) );
+                for (int k = -1; k < 3001; ++k)
+                {
+                    auto it = map.find(k);
+                    REQUIRE( tree.contains(k) == (it != map.end()) );
+                    REQUIRE( tree.get(k) == (it != map.end() ? it->second : 0) );
+                }
+            }
+        }
+        WHEN( "Searching nearest keys" ) {
+            THEN( "Floor, ceiling, rank and select are the same as in the map" ) {
+                for (int k = -1; k < 3001; ++k)
+                {
+                    auto upper = map.upper_bound(k);
+                    auto lower = map.lower_bound(k);
+                    const int * floor = tree.floor(k);
+                    const int * ceiling = tree.ceiling(k);
+                    REQUIRE( (floor == nullptr) == (upper == map.begin()) );
+                    if (floor != nullptr)
+                        REQUIRE( *floor == std::prev(upper)->first );
+                    REQUIRE( (ceiling == nullptr) == (lower == map.end()) );
+                    if (ceiling != nullptr)
+                        REQUIRE( *ceiling == lower->first );
+
+                    size_t rank = static_cast<size_t>(std::distance(map.begin(), lower));
+                    REQUIRE( tree.rank(k) == rank );
+                    if (rank < map.size())
+                        REQUIRE( *tree.select(rank) == lower->first );
+                }
+                REQUIRE( tree.select(map.size()) == nullptr );
+            }
+        }
+        WHEN( "Getting keys" ) {
+            std::vector<int> all;
+            for (const auto & item : map)
+                all.push_back(item.first);
+            THEN( "Keys are sorted" ) {
+                REQUIRE( tree.keys() == all );
+                REQUIRE( tree.keys(101, 1001) == std::vector<int>(map.lower_bound(101) == map.end() ? all.end() :
+                            all.begin() + std::distance(map.begin(), map.lower_bound(101)),
+                            all.begin() + std::distance(map.begin(), map.upper_bound(1001))) );
+                REQUIRE( tree.keys(5000, 6000).empty() );
+            }
+        }
+    }
+    GIVEN( "BPlusTree of default order filled by increasing keys" ) {
+        bst::BPlusTree<long, long> tree;
+        for (long i = 1; i <= 100000; ++i)
+            tree.put(i, i * 10);
+
+        WHEN( "Scanning range" ) {
+            long sum = 0;
+            tree.forEach(10, 19, [&sum](long, long v) { sum += v; });
+            THEN( "Items of the range are visited" ) {
+                REQUIRE( sum == 1450 );
+                REQUIRE( tree.size() == static_cast<size_t>(100000) );
+                REQUIRE( tree.height() <= static_cast<size_t>(5) );
+                REQUIRE( tree.rank(50000) == static_cast<size_t>(49999) );
+            }
+        }
+    }
+    GIVEN( "Empty BPlusTree" ) {
+        bst::BPlusTree<std::string, int> tree;
+        THEN( "Nothing is found" ) {
+            REQUIRE( tree.get("a") == 0 );
+            REQUIRE( tree.floor("a") == nullptr );
+            REQUIRE( tree.ceiling("a") == nullptr );
+            REQUIRE( tree.select(0) == nullptr );
+            REQUIRE( tree.keys().empty() );
+        }
+    }
+}
+
+SCENARIO( "Bst in-order iteration testing", "[bst]" ) {
+    GIVEN( "BstRedBlack with some items" ) {
+        bst::BstRedBlack<int, int> bstRb;
+        std::vector<int> keys;
+        for (int i = 0; i < 300; ++i)
+        {
+            bstRb.put((i * 7919) % 300 * 3, 0);
+            keys.push_back(i * 3);
+        }
+
+        WHEN( "Iterating over the whole tree" ) {
+            std::vector<int> forward;
+            for (auto it = bstRb.begin(); it != bstRb.end(); ++it)
+                forward.push_back(it->key);
+            std::vector<int> backward;
+            for (auto it = bstRb.end(); it != bstRb.begin(); )
+                backward.push_back((--it)->key);
+            THEN( "Keys are visited in order in both directions" ) {
+                REQUIRE( forward == keys );
+                REQUIRE( std::vector<int>(backward.rbegin(), backward.rend()) == keys );
+            }
+        }
+        WHEN( "Iterating over the range" ) {
+            std::vector<int> inner;
+            for (const auto & node : bstRb.range(10, 30))
+                inner.push_back(node.key);
+            std::vector<int> exact;
+            for (const auto & node : bstRb.range(12, 30))
+                exact.push_back(node.key);
+            THEN( "Only keys within the range are visited" ) {
+                REQUIRE( inner == std::vector<int>{ 12, 15, 18, 21, 24, 27, 30 } );
+                REQUIRE( exact == inner );
+                REQUIRE( bstRb.range(1000, 2000).begin() == bstRb.range(1000, 2000).end() );
+                REQUIRE( bstRb.range(30, 10).begin() == bstRb.range(30, 10).end() );
+                REQUIRE( bstRb.range(-10, 0).begin()->key == 0 );
+            }
+        }
+    }
+    GIVEN( "Degenerate BinarySearchTree made from reversed keys" ) {
+        bst::BinarySearchTree<int, int, bst::NodeHeap> bst;
+        const int count = 500;
+        for (int i = count; i-- > 0; )
+            bst.put(i, 0);
+
+        WHEN( "Iterating over the whole tree" ) {
+            std::vector<int> forward;
+            for (auto it = bst.begin(); it != bst.end(); ++it)
+                forward.push_back(it->key);
+            std::vector<int> backward;
+            for (auto it = bst.end(); it != bst.begin(); )
+                backward.push_back((--it)->key);
+            THEN( "Keys are visited in order by the iterator of two pointers" ) {
+                REQUIRE( sizeof(bst::BinarySearchTree<int, int, bst::NodeHeap>::Iterator) == 2 * sizeof(void *) );
+                REQUIRE( forward.size() == static_cast<size_t>(count) );
+                REQUIRE( std::is_sorted(forward.begin(), forward.end()) );
+                REQUIRE( std::vector<int>(backward.rbegin(), backward.rend()) == forward );
+            }
+        }
+    }
+    GIVEN( "Degenerate BinarySearchTree made from sorted keys" ) {
+        bst::BinarySearchTree<int, int, bst::NodeHeap> bst;
+        const int count = 5000;
+        for (int i = 0; i < count; ++i)
+            bst.put(i, 0);
+
+        WHEN( "Walking through the tree" ) {
+            size_t visited = 0;
+            for (const auto & node : bst.range(100, count))
+                visited += static_cast<size_t>(node.val);
+            THEN( "Helpers work without recursion" ) {
+                REQUIRE( visited == static_cast<size_t>(count - 100) );
+                REQUIRE( bst.valueSum() == count );
+                REQUIRE( bst.rank(count - 1) == static_cast<size_t>(count - 1) );
+                REQUIRE( bst.select(count - 1) == count - 1 );
+                REQUIRE( bst.floor(count + 5) == count - 1 );
+                REQUIRE( bst.keys().size() == static_cast<size_t>(count) );
+            }
+            bst.clear();
+            THEN( "Tree is cleared" ) {
+                REQUIRE( bst.size() == static_cast<size_t>(0) );
+                REQUIRE( bst.keys().empty() );
+            }
+        }
+    }
+}
+
+SCENARIO( "RedBlack range aggregates testing", "[bst_rb]" ) {
+    GIVEN( "BstRedBlack trees with sum, min and max aggregates" ) {
+        bst::BstRedBlack<int, long, bst::NodePool, bst::SumAggregate<long>> sums;
+        bst::BstRedBlack<int, long, bst::NodePool, bst::MinAggregate<long>> mins;
+        bst::BstRedBlack<int, long, bst::NodePool, bst::MaxAggregate<long>> maxs;
+        std::map<int, long> map;
+        for (int i = 0; i < 600; ++i)
+        {
+            int k = (i * 7919) % 400;
+            sums.put(k, 0);
+            mins.put(k, 0);
+            maxs.put(k, 0);
+            ++map[k];
+        }
+        for (int k = 0; k < 400; k += 5)
+        {
+            sums.deleteNode(k);
+            mins.deleteNode(k);
+            maxs.deleteNode(k);
+            map.erase(k);
+        }
+        sums.deleteMin();
+        mins.deleteMin();
+        maxs.deleteMin();
+        map.erase(map.begin());
+
+        WHEN( "Querying ranges" ) {
+            THEN( "Aggregates are the same as calculated by the map" ) {
+                REQUIRE( bst::testRbIsBalanced(sums) );
+                long total = 0;
+                for (const auto & item : map)
+                    total += item.second;
+                REQUIRE( sums.aggregate() == total );
+
+                for (int lo = -5; lo < 405; lo += 7)
+                {
+                    for (int hi = lo - 3; hi < 405; hi += 11)
+                    {
+                        long sum = 0;
+                        long min = std::numeric_limits<long>::max();
+                        long max = std::numeric_limits<long>::lowest();
+                        for (auto it = map.lower_bound(lo); it != map.end() && it->first <= hi; ++it)
+                        {
+                            sum += it->second;
+                            min = std::min(min, it->second);
+                            max = std::max(max, it->second);
+                        }
+                        REQUIRE( sums.aggregate(lo, hi) == sum );
+                        REQUIRE( mins.aggregate(lo, hi) == min );
+                        REQUIRE( maxs.aggregate(lo, hi) == max );
+                    }
+                }
+            }
+        }
+    }
+    GIVEN( "BstRedBlack with user defined monoid" ) {
+        // concatenation is not commutative, so it checks that values are joined in key order
+        struct Concat
+        {
+            using Type = std::string;
+            static Type identity() { return ""; }
+            static Type of(const std::string & v) { return v; }
+            static Type combine(const Type & a, const Type & b) { return a + b; }
+        };
+        bst::BstRedBlack<int, std::string, bst::NodeHeap, Concat> tree;
+        std::vector<std::pair<int, std::string>> items;
+        for (int i = 0; i < 26; ++i)
+            items.emplace_back(i, std::string(1, static_cast<char>('a' + i)));
+        tree.build(items.begin(), items.end());
+
+        WHEN( "Querying ranges" ) {
+            THEN( "Values are combined in the order of keys" ) {
+                REQUIRE( tree.aggregate() == "abcdefghijklmnopqrstuvwxyz" );
+                REQUIRE( tree.aggregate(3, 7) == "defgh" );
+                REQUIRE( tree.aggregate(-10, 2) == "abc" );
+                REQUIRE( tree.aggregate(7, 3) == "" );
+            }
+        }
+    }
+}
+
+SCENARIO( "SkipListConcurrent testing", "[bst_skiplist]" ) {
+    GIVEN( "SkipListConcurrent filled by many threads" ) {
+        bst::SkipListConcurrent<int, long> list;
+        const int threads = 4;
+        const int count = 20000;
+        std::vector<std::thread> writers;
+        for (int t = 0; t < threads; ++t)
+        {
+            writers.emplace_back([&list, t]()
+            {
+                // every thread puts its own odd keys and the even keys shared by all threads
+                for (int i = 0; i < count; ++i)
+                {
+                    int k = (i * 7919 + t * 13) % count;
+                    list.put(k * 8 + 1 + t * 2, k);
+                    list.put(k * 8, 7);
+                }
+            });
+        }
+        for (auto & writer : writers)
+            writer.join();
+
+        WHEN( "Reading the list" ) {
+            THEN( "All items are present and ordered" ) {
+                std::vector<int> keys = list.keys(0, count * 8);
+                REQUIRE( list.size() == static_cast<size_t>(count * (threads + 1)) );
+                REQUIRE( keys.size() == static_cast<size_t>(count * (threads + 1)) );
+                REQUIRE( std::is_sorted(keys.begin(), keys.end()) );
+                REQUIRE( std::adjacent_find(keys.begin(), keys.end()) == keys.end() );
+                REQUIRE( list.get(8) == 7 );
+                REQUIRE( list.get(8 * 10 + 3) == 10 );
+                REQUIRE( list.get(8 * 10 + 2) == 0 );
+                REQUIRE_FALSE( list.contains(-1) );
+            }
+            THEN( "Every level is complete and sorted" ) {
+                REQUIRE( list.isConsistent() );
+            }
+            THEN( "Nearest keys are found" ) {
+                REQUIRE( *list.floor(82) == 81 );
+                REQUIRE( *list.floor(81) == 81 );
+                REQUIRE( *list.ceiling(82) == 83 );
+                REQUIRE( *list.ceiling(88) == 88 );
+                REQUIRE( list.floor(-1) == nullptr );
+                REQUIRE( list.ceiling(count * 8) == nullptr );
+            }
+            THEN( "Range is visited in order" ) {
+                long sum = 0;
+                list.forEach(80, 84, [&sum](int, long v) { sum += v; });
+                REQUIRE( sum == 7 + 10 + 10 );
+            }
+        }
+    }
+}
+
+SCENARIO( "SkipListConcurrent levels under contention", "[bst_skiplist]" ) {
+    GIVEN( "SkipListConcurrent filled by threads with interleaved keys" ) {
+        bst::SkipListConcurrent<int, int> list;
+        const int threads = 8;
+        const int count = 5000;
+        std::vector<std::thread> writers;
+        for (int t = 0; t < threads; ++t)
+        {
+            // neighbour keys are put by different threads at the same time
+            writers.emplace_back([&list, t]()
+            {
+                for (int i = 0; i < count; ++i)
+                    list.put(i * threads + t, t);
+            });
+        }
+        for (auto & writer : writers)
+            writer.join();
+
+        THEN( "Every level is complete and sorted" ) {
+            REQUIRE( list.size() == static_cast<size_t>(count * threads) );
+            REQUIRE( list.isConsistent() );
+        }
+    }
+}
+
 } // namespace tests
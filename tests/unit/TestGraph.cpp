@@ -7,6 +7,7 @@
 #include "catch2/catch.hpp"
 #include "Graph.hpp"
 #include "GraphAlgorithms.hpp"
+#include "DynamicConnectivity.hpp"
 #include "MinimalSpanningTree.hpp"
 #include "ShortPaths.hpp"
 //--------------------------------------------------------------------------------------------------
@@ -59,6 +60,19 @@ SCENARIO( "Graph testing", "[graph]" ) {
                 REQUIRE_FALSE( graph::Cyclic<graph::Graph>{gr}.isCyclic() );
             }
         }
+        WHEN( "Coupled components are searched in parallel" ) {
+            graph::CoupledComponents coupledComponents(graph);
+            graph::ParallelCoupledComponents<graph::Graph> parallelComponents(graph, 3);
+            THEN( "Parallel search gives the same components" ) {
+                REQUIRE( static_cast<size_t>(2) == parallelComponents.componentsCount() );
+                REQUIRE( parallelComponents.connected(0, 1) );
+                REQUIRE_FALSE( parallelComponents.connected(0, 5) );
+                for (size_t v = 0; v < graph.vertexCount(); ++v)
+                {
+                    REQUIRE( coupledComponents.id(v) == parallelComponents.id(v) );
+                }
+            }
+        }
         WHEN( "Depth-first search of the graph" ) {
             std::vector<bool> b(graph.vertexCount());
             graph::depthFirstSearh(graph, 0, b);
@@ -310,6 +324,50 @@ SCENARIO( "Graph testing", "[graph]" ) {
 
 }
 
+SCENARIO( "OfflineDynamicConnectivity testing", "[dynamic_connectivity]" ) {
+    GIVEN( "History of edge additions and removals" ) {
+        graph::OfflineDynamicConnectivity dc{5};
+        dc.addEdge(0, 1);                       // t = 1
+        dc.addEdge(1, 2);                       // t = 2
+        dc.addEdge(2, 1);                       // t = 3, parallel edge
+        dc.removeEdge(1, 2);                    // t = 4
+        dc.addEdge(3, 4);                       // t = 5
+        dc.removeEdge(0, 1);                    // t = 6
+        dc.removeEdge(2, 1);                    // t = 7
+
+        WHEN( "Queries about different moments are solved" ) {
+            auto q0 = dc.query(0, 1, 0);
+            auto q1 = dc.query(0, 2, 2);
+            auto q2 = dc.query(0, 2, 4);
+            auto q3 = dc.query(3, 4, 4);
+            auto q4 = dc.query(3, 4, 7);
+            auto q5 = dc.query(0, 2, 6);
+            auto q6 = dc.query(1, 2, 7);
+            auto answers = dc.solve();
+            THEN( "Connectivity at every moment returns" ) {
+                REQUIRE_FALSE( answers[q0] );
+                REQUIRE( answers[q1] );
+                REQUIRE( answers[q2] );
+                REQUIRE_FALSE( answers[q3] );
+                REQUIRE( answers[q4] );
+                REQUIRE_FALSE( answers[q5] );
+                REQUIRE_FALSE( answers[q6] );
+            }
+        }
+        WHEN( "Absent edge is removed" ) {
+            THEN( "Exception is thrown" ) {
+                REQUIRE_THROWS_AS( dc.removeEdge(0, 4), std::invalid_argument );
+            }
+        }
+        WHEN( "Query is made after the last event" ) {
+            dc.query(0, 1, dc.time() + 1);
+            THEN( "Exception is thrown" ) {
+                REQUIRE_THROWS_AS( dc.solve(), std::out_of_range );
+            }
+        }
+    }
+}
+
 SCENARIO( "MinimalSpanningTree testing", "[mst]" ) {
     using Strategy = graph::NonDirectedGraphPolicy<graph::EdgeWeightedGraph>;
     using Edge = graph::EdgeWeightedGraph::EdgeType;
@@ -6,6 +6,14 @@
 //--------------------------------------------------------------------------------------------------
 #include "catch2/catch.hpp"
 #include "HashTableChaining.hpp"
+#include "HashTableConcurrent.hpp"
+#include "HashTableRobinHood.hpp"
+#include "HashTableStatic.hpp"
+#include "Tools.hpp"
+
+#include <cstdio>
+#include <set>
+#include <thread>
 
 //--------------------------------------------------------------------------------------------------
 
@@ -57,4 +65,385 @@ SCENARIO( "HashTable testing", "[hash_table]" ) {
     }
 }
 
+SCENARIO( "HashTableChaining resizing testing", "[hash_table]" ) {
+    GIVEN( "HashTableChaining with few buckets" ) {
+        hash::HashTableChaining<size_t, size_t> hashTable(8);
+        const size_t count = 1000;
+        bool rehashingSeen = false;
+        for (size_t i = 0; i < count; ++i)
+        {
+            hashTable.put(i, i + 1);
+            rehashingSeen = rehashingSeen || hashTable.rehashing();
+            REQUIRE( i + 1 == hashTable.get(i) );
+        }
+
+        WHEN( "Many items were added" ) {
+            THEN( "Table grows incrementally and keeps all items" ) {
+                REQUIRE( rehashingSeen );
+                REQUIRE( count == hashTable.size() );
+                REQUIRE( hashTable.bucketsCount() >= count / 2 );
+                for (size_t i = 0; i < count; ++i)
+                {
+                    REQUIRE( i + 1 == hashTable.get(i) );
+                }
+            }
+        }
+        WHEN( "Most of items were deleted" ) {
+            for (size_t i = 0; i < count - 10; ++i)
+            {
+                hashTable.del(i);
+            }
+            // deleting of absent items moves rehashing forward as well
+            for (size_t i = 0; i < count; ++i)
+            {
+                hashTable.del(count + i);
+            }
+            THEN( "Table shrinks and keeps remaining items" ) {
+                REQUIRE( static_cast<size_t>(10) == hashTable.size() );
+                REQUIRE( hashTable.bucketsCount() < static_cast<size_t>(128) );
+                REQUIRE( static_cast<size_t>(0) == hashTable.get(0) );
+                for (size_t i = count - 10; i < count; ++i)
+                {
+                    REQUIRE( i + 1 == hashTable.get(i) );
+                }
+            }
+        }
+    }
+}
+
+SCENARIO( "HashTableChaining bulk load and statistics testing", "[hash_table]" ) {
+    GIVEN( "HashTableChaining loaded by batch" ) {
+        hash::HashTableChaining<size_t, size_t> hashTable(4);
+        std::vector<std::pair<size_t, size_t>> items;
+        for (size_t i = 0; i < 500; ++i)
+        {
+            items.emplace_back(i, i * 2);
+        }
+        hashTable.putAll(items.begin(), items.end());
+
+        WHEN( "Batch was loaded" ) {
+            THEN( "Table is sized once and holds all items" ) {
+                REQUIRE_FALSE( hashTable.rehashing() );
+                REQUIRE( static_cast<size_t>(512) == hashTable.bucketsCount() );
+                REQUIRE( static_cast<size_t>(500) == hashTable.size() );
+                REQUIRE( static_cast<size_t>(998) == hashTable.get(499) );
+            }
+        }
+        WHEN( "Items are iterated" ) {
+            hashTable.put(1000, 1);
+            size_t count = 0;
+            size_t keySum = 0;
+            for (auto const & item : hashTable)
+            {
+                ++count;
+                keySum += item.first;
+            }
+            THEN( "Every item is visited once" ) {
+                REQUIRE( static_cast<size_t>(501) == count );
+                REQUIRE( static_cast<size_t>(499 * 500 / 2 + 1000) == keySum );
+            }
+        }
+        WHEN( "Statistics are calculated" ) {
+            auto stats = hashTable.stats();
+            THEN( "Distribution of the items returns" ) {
+                REQUIRE( static_cast<size_t>(500) == stats.items );
+                REQUIRE( static_cast<size_t>(512) == stats.buckets );
+                REQUIRE( stats.usedBuckets > 0 );
+                REQUIRE( stats.maxChain >= 1 );
+                REQUIRE( stats.maxChain < 10 );
+                REQUIRE( stats.avgProbes >= 1.0 );
+                REQUIRE( stats.bytes > 500 * sizeof(std::pair<size_t, size_t>) );
+            }
+        }
+    }
+    GIVEN( "Empty HashTableChaining" ) {
+        hash::HashTableChaining<size_t, size_t> hashTable(4);
+        WHEN( "Items are iterated" ) {
+            THEN( "Nothing is visited" ) {
+                REQUIRE( hashTable.begin() == hashTable.end() );
+            }
+        }
+        WHEN( "Default constructed iterators are compared" ) {
+            using Iterator = hash::HashTableChaining<size_t, size_t>::ConstIterator;
+            THEN( "They are equal to each other and not equal to iterators of the table" ) {
+                REQUIRE( Iterator() == Iterator() );
+                REQUIRE( Iterator() != hashTable.end() );
+                REQUIRE( hashTable.end() != Iterator() );
+            }
+        }
+    }
+}
+
+SCENARIO( "Hash functions testing", "[hash_table]" ) {
+    GIVEN( "Sequential ids" ) {
+        const size_t buckets = 1024;
+        const auto shift = hash::fibonacciShift(buckets);
+        WHEN( "Ids are mapped to the buckets" ) {
+            std::set<size_t> used;
+            for (size_t id = 0; id < buckets; ++id)
+            {
+                used.insert(hash::fibonacciIndex(hash::Hasher<size_t>{}(id * buckets), shift));
+            }
+            THEN( "Most of the buckets are used" ) {
+                REQUIRE( used.size() > buckets / 2 );
+            }
+        }
+    }
+    GIVEN( "HashTableChaining with string keys" ) {
+        hash::HashTableChaining<std::string, size_t> hashTable(16);
+        for (size_t i = 0; i < 100; ++i)
+        {
+            hashTable.put("name" + std::to_string(i), i);
+        }
+        WHEN( "Items are retrieved by string keys" ) {
+            THEN( "Proper values return" ) {
+                REQUIRE( static_cast<size_t>(0) == hashTable.get("name0") );
+                REQUIRE( static_cast<size_t>(42) == hashTable.get("name42") );
+                REQUIRE( static_cast<size_t>(99) == hashTable.get("name99") );
+                REQUIRE( static_cast<size_t>(0) == hashTable.get("name100") );
+            }
+        }
+    }
+    GIVEN( "HashTableChaining with custom hash function" ) {
+        struct ConstantHash { size_t operator()(size_t) const { return 7; } };
+        hash::HashTableChaining<size_t, std::string, ConstantHash> hashTable(8);
+        hashTable.put(1, "one");
+        hashTable.put(2, "two");
+        WHEN( "All keys share one bucket" ) {
+            hashTable.del(1);
+            THEN( "Items are still distinguished by keys" ) {
+                REQUIRE( "" == hashTable.get(1) );
+                REQUIRE( "two" == hashTable.get(2) );
+            }
+        }
+    }
+}
+
+SCENARIO( "HashTableConcurrent testing", "[hash_table]" ) {
+    GIVEN( "HashTableConcurrent filled from many threads" ) {
+        hash::HashTableConcurrent<size_t, std::string> hashTable(1024, 8);
+        const size_t count = 4000;
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < 4; ++t)
+        {
+            threads.emplace_back([&hashTable, t, count]() {
+                for (size_t i = t; i < count; i += 4)
+                {
+                    hashTable.put(i, std::to_string(i));
+                    if (i % 3 == 0)
+                    {
+                        hashTable.del(i);
+                    }
+                }
+            });
+        }
+        for (auto & thread : threads)
+        {
+            thread.join();
+        }
+
+        WHEN( "Items are retrieved one by one" ) {
+            THEN( "All threads' items are present" ) {
+                REQUIRE( static_cast<size_t>(8) == hashTable.shards() );
+                for (size_t i = 0; i < count; ++i)
+                {
+                    REQUIRE( (i % 3 ? std::to_string(i) : std::string{}) == hashTable.get(i) );
+                }
+            }
+        }
+        WHEN( "Items are retrieved by batch" ) {
+            auto values = hashTable.get(std::vector<size_t>{5, 3, count + 1, 7});
+            THEN( "Values return in the order of the keys" ) {
+                REQUIRE( std::vector<std::string>{"5", "", "", "7"} == values );
+            }
+        }
+    }
+}
+
+namespace
+{
+
+/// @brief Weak hash function which maps many keys to the same value
+struct ParityHash
+{
+    size_t operator()(uint64_t k) const { return k % 2; }
+};
+
+} // namespace
+
+SCENARIO( "HashTableStatic testing", "[hash_table]" ) {
+    const std::string fileName = tools::temporaryFile("hash_table_static");
+
+    GIVEN( "HashTableStatic built from HashTableChaining" ) {
+        hash::HashTableChaining<uint64_t, double> source(16);
+        const uint64_t count = 5000;
+        for (uint64_t i = 0; i < count; ++i)
+        {
+            source.put(i * 7, i / 2.0);
+        }
+        hash::HashTableStatic<uint64_t, double>::build(source.begin(), source.end(), fileName);
+
+        WHEN( "Table is mapped from the file" ) {
+            hash::HashTableStatic<uint64_t, double> table(fileName);
+            THEN( "All items can be retrieved" ) {
+                REQUIRE( count == table.size() );
+                for (uint64_t i = 0; i < count; ++i)
+                {
+                    REQUIRE( source.get(i * 7) == table.get(i * 7) );
+                }
+                REQUIRE_FALSE( table.contains(1) );
+                REQUIRE( 0.0 == table.get(count * 7) );
+            }
+        }
+        std::remove(fileName.c_str());
+    }
+    GIVEN( "Items with duplicated keys" ) {
+        std::vector<std::pair<uint64_t, double>> items{{1, 1.0}, {2, 2.0}, {1, 3.0}};
+        WHEN( "Table is built" ) {
+            THEN( "Exception is thrown" ) {
+                REQUIRE_THROWS_AS( (hash::HashTableStatic<uint64_t, double>::build(items.begin(), items.end(), fileName)),
+                                   std::invalid_argument );
+            }
+        }
+    }
+    GIVEN( "Items with distinct keys and equal hashes" ) {
+        std::vector<std::pair<uint64_t, double>> items{{1, 1.0}, {2, 2.0}, {3, 3.0}};
+        WHEN( "Table is built" ) {
+            THEN( "Exception is thrown instead of endless search" ) {
+                REQUIRE_THROWS_AS( (hash::HashTableStatic<uint64_t, double, ParityHash>::build(items.begin(), items.end(), fileName)),
+                                   std::runtime_error );
+            }
+        }
+    }
+    GIVEN( "Empty items" ) {
+        std::vector<std::pair<uint64_t, double>> items;
+        hash::HashTableStatic<uint64_t, double>::build(items.begin(), items.end(), fileName);
+        WHEN( "Table is mapped from the file" ) {
+            hash::HashTableStatic<uint64_t, double> table(fileName);
+            THEN( "Nothing is found" ) {
+                REQUIRE( static_cast<size_t>(0) == table.size() );
+                REQUIRE_FALSE( table.contains(1) );
+            }
+        }
+    }
+    std::remove(fileName.c_str());
+}
+
+SCENARIO( "HashTableRobinHood testing", "[hash_table]" ) {
+    GIVEN( "HashTable HashTableRobinHood" ) {
+        hash::HashTableRobinHood<size_t, std::string> hashTable;
+        hashTable.put(1, "world");
+
+        WHEN( "Item was added to the hash table" ) {
+            THEN( "It was saved correctly and can be retrieved" ) {
+                REQUIRE( "world" == hashTable.get(1) );
+                REQUIRE( static_cast<size_t>(1) == hashTable.size() );
+            }
+        }
+        WHEN( "Item with the same key was added to the hash table" ) {
+            hashTable.put(1, "table");
+            THEN( "The value of the item is replaced by the new" ) {
+                REQUIRE( "table" == hashTable.get(1) );
+                REQUIRE( static_cast<size_t>(1) == hashTable.size() );
+            }
+        }
+        WHEN( "Retrieve vale of unexisting item" ) {
+            THEN( "Value-initialized value returns" ) {
+                REQUIRE( "" == hashTable.get(2) );
+            }
+        }
+        WHEN( "Delete the item" ) {
+            hashTable.del(1);
+            THEN( "Item was deleted" ) {
+                REQUIRE( "" == hashTable.get(1) );
+                REQUIRE( static_cast<size_t>(0) == hashTable.size() );
+            }
+        }
+        WHEN( "Many items were added and half of them deleted" ) {
+            const size_t count = 10000;
+            for (size_t i = 0; i < count; ++i)
+            {
+                hashTable.put(i, std::to_string(i));
+            }
+            for (size_t i = 0; i < count; i += 2)
+            {
+                hashTable.del(i);
+            }
+            THEN( "Table grows and keeps all remaining items" ) {
+                REQUIRE( count / 2 == hashTable.size() );
+                REQUIRE( hashTable.loadFactor() <= 0.875 );
+                for (size_t i = 0; i < count; ++i)
+                {
+                    REQUIRE( (i % 2 ? std::to_string(i) : std::string{}) == hashTable.get(i) );
+                }
+            }
+        }
+    }
+}
+
+namespace
+{
+
+/// @brief Hash function which maps all keys to the same value
+struct ConstantHash
+{
+    size_t operator()(size_t) const { return 42; }
+};
+
+/// @brief Hash function which starts to map all keys to the same value when it is switched
+struct SwitchedHash
+{
+    static bool collide;
+    size_t operator()(size_t k) const { return collide ? 42 : k; }
+};
+
+bool SwitchedHash::collide = false;
+
+} // namespace
+
+SCENARIO( "HashTableRobinHood with the weak hash function", "[hash_table]" ) {
+    GIVEN( "HashTableRobinHood where all keys have the same hash" ) {
+        hash::HashTableRobinHood<size_t, size_t, ConstantHash> hashTable;
+
+        WHEN( "More items are added than max distance allows" ) {
+            size_t added = 0;
+            THEN( "Exception is thrown instead of endless growth" ) {
+                REQUIRE_THROWS_AS( [&]() { for (; added < 1000; ++added) hashTable.put(added, added * 2); }(),
+                                   std::length_error );
+                REQUIRE( added == hashTable.size() );
+                REQUIRE( hashTable.capacity() <= 1024 );
+                for (size_t i = 0; i < added; ++i)
+                {
+                    REQUIRE( i * 2 == hashTable.get(i) );
+                }
+                REQUIRE( 0 == hashTable.get(added) );
+            }
+        }
+    }
+    GIVEN( "HashTableRobinHood which is full before the growth" ) {
+        hash::HashTableRobinHood<size_t, size_t, SwitchedHash> hashTable;
+        const size_t count = 448;
+        for (size_t i = 0; i < count; ++i)
+        {
+            hashTable.put(i, i * 2);
+        }
+
+        WHEN( "Items can not be placed by the growth" ) {
+            SwitchedHash::collide = true;
+            THEN( "Exception is thrown and the table is not changed" ) {
+                REQUIRE( 512 == hashTable.capacity() );
+                REQUIRE_THROWS_AS( hashTable.put(count, 0), std::length_error );
+                SwitchedHash::collide = false;
+                REQUIRE( count == hashTable.size() );
+                REQUIRE( 512 == hashTable.capacity() );
+                for (size_t i = 0; i < count; ++i)
+                {
+                    REQUIRE( i * 2 == hashTable.get(i) );
+                }
+            }
+            SwitchedHash::collide = false;
+        }
+    }
+}
+
 } // namespace tests
@@ -5,7 +5,22 @@
 
 //--------------------------------------------------------------------------------------------------
 #include "catch2/catch.hpp"
+#include "ExternalSort.hpp"
 #include "Sort_Impl.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
 //--------------------------------------------------------------------------------------------------
 
 namespace tests
@@ -120,6 +135,935 @@ SCENARIO( "Sort unsorted vector", "[sort]" ) {
             sort::InsertionBinarySort<int>().sort(v);
             THEN( "Vector becomes sorted" ) { REQUIRE( tools::isSorted(v) ); }
         }
+        WHEN( "ParallelMerge sort algorithm applied" ) {
+            sort::ParallelMergeSort<int>().sort(v);
+            THEN( "Vector becomes sorted" ) { REQUIRE( tools::isSorted(v) ); }
+        }
+        WHEN( "ParallelQuick sort algorithm applied" ) {
+            sort::ParallelQuickSort<int>().sort(v);
+            THEN( "Vector becomes sorted" ) { REQUIRE( tools::isSorted(v) ); }
+        }
+        WHEN( "Power sort algorithm applied" ) {
+            sort::PowerSort<int>().sort(v);
+            THEN( "Vector becomes sorted" ) { REQUIRE( tools::isSorted(v) ); }
+        }
+        WHEN( "Pdq sort algorithm applied" ) {
+            sort::PdqSort<int>().sort(v);
+            THEN( "Vector becomes sorted" ) { REQUIRE( tools::isSorted(v) ); }
+        }
+        WHEN( "LsdRadix sort algorithm applied" ) {
+            sort::LsdRadixSort<int>().sort(v);
+            THEN( "Vector becomes sorted" ) { REQUIRE( tools::isSorted(v) ); }
+        }
+        WHEN( "AmericanFlag sort algorithm applied" ) {
+            sort::AmericanFlagSort<int>().sort(v);
+            THEN( "Vector becomes sorted" ) { REQUIRE( tools::isSorted(v) ); }
+        }
+    }
+}
+
+SCENARIO( "Task pool testing", "[tools]" ) {
+
+    GIVEN( "Task pool with several workers" ) {
+        tools::TaskPool pool(3);
+
+        WHEN( "One of the tasks throws" ) {
+            std::atomic<int> done(0);
+            std::vector<std::function<void()>> tasks;
+            for (int i = 0; i < 16; ++i)
+            {
+                tasks.push_back([&done, i]()
+                {
+                    if (i % 5 == 3)
+                        throw std::runtime_error("task failed");
+                    ++done;
+                });
+            }
+            THEN( "The exception is rethrown after the other tasks are done" ) {
+                REQUIRE_THROWS_AS( pool.run(tasks), std::runtime_error );
+                REQUIRE( done == 13 );
+            }
+            THEN( "The pool is still usable" ) {
+                REQUIRE_THROWS( pool.run(tasks) );
+                int sum = 0;
+                pool.run([&sum]() { sum += 1; }, [&sum]() { (void)sum; });
+                REQUIRE( sum == 1 );
+            }
+        }
+        WHEN( "Nested task throws" ) {
+            auto nested = [&pool]() { pool.run([]() {}, []() { throw std::logic_error("nested"); }); };
+            THEN( "The exception reaches the outer run" ) {
+                REQUIRE_THROWS_AS( pool.run(nested, nested), std::logic_error );
+            }
+        }
+        WHEN( "The pool has no work" ) {
+            pool.run([]() {}, []() {});
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            std::clock_t start = std::clock();
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            double busy = static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+            THEN( "Workers sleep instead of spinning" ) { REQUIRE( busy < 0.05 ); }
+        }
+    }
+}
+
+namespace
+{
+
+/// @brief Item compared by the key only, counts comparisons (also made by the pool threads)
+struct Event
+{
+    int key;
+    int seq;
+    static std::atomic<size_t> comparisons;
+    bool operator< (const Event & other) const { ++comparisons; return key < other.key; }
+    bool operator== (const Event & other) const { return key == other.key && seq == other.seq; }
+};
+
+std::atomic<size_t> Event::comparisons(0);
+
+} // namespace
+
+SCENARIO( "Sort big vector in parallel", "[sort_parallel]" ) {
+
+    GIVEN( "Big vector with random items and duplicates" ) {
+        std::vector<int> v;
+        tools::randomData(v, 200000, 0, 5000);
+        std::vector<int> expected = v;
+        std::sort(expected.begin(), expected.end());
+        tools::TaskPool pool(3);
+
+        WHEN( "ParallelMerge sort algorithm applied" ) {
+            sort::ParallelMergeSort<int>::sort(v, pool);
+            THEN( "Vector becomes sorted" ) { REQUIRE( v == expected ); }
+        }
+        WHEN( "ParallelQuick sort algorithm applied" ) {
+            sort::ParallelQuickSort<int>::sort(v, pool);
+            THEN( "Vector becomes sorted" ) { REQUIRE( v == expected ); }
+        }
+        WHEN( "Parallel sorts use the shared pool" ) {
+            std::vector<int> w = v;
+            sort::ParallelMergeSort<int>::sort(v);
+            sort::ParallelQuickSort<int>::sort(w);
+            THEN( "Vectors become sorted" ) {
+                REQUIRE( v == expected );
+                REQUIRE( w == expected );
+            }
+        }
+    }
+    GIVEN( "Big vectors with patterns which break quick sort with the median of three" ) {
+        const int k = 100000;
+        std::vector<int> killer(2 * k);
+        for (int i = 1; i <= k; ++i)
+        {
+            if (i % 2 == 1)
+            {
+                killer[i - 1] = i;
+                killer[i] = k + i;
+            }
+            killer[k + i - 1] = 2 * i;
+        }
+        std::vector<int> equal(2 * k, 7);
+        std::vector<int> reversed(2 * k);
+        for (int i = 0; i < 2 * k; ++i)
+            reversed[i] = 2 * k - i;
+        tools::TaskPool pool(3);
+
+        WHEN( "ParallelQuick sort algorithm applied" ) {
+            for (auto * v : {&killer, &equal, &reversed})
+                sort::ParallelQuickSort<int>::sort(*v, pool);
+            THEN( "Vectors become sorted" ) {
+                REQUIRE( std::is_sorted(killer.begin(), killer.end()) );
+                REQUIRE( std::is_sorted(equal.begin(), equal.end()) );
+                REQUIRE( std::is_sorted(reversed.begin(), reversed.end()) );
+            }
+        }
+    }
+    GIVEN( "Big vector of records with equal keys" ) {
+        std::vector<Event> v;
+        for (int i = 0; i < 100000; ++i)
+            v.push_back({(i * 7919) % 100, i});
+        std::vector<Event> expected = v;
+        std::stable_sort(expected.begin(), expected.end());
+
+        WHEN( "ParallelMerge sort algorithm applied" ) {
+            sort::ParallelMergeSort<Event>::sort(v);
+            THEN( "Vector becomes sorted, equal records keep the order" ) { REQUIRE( v == expected ); }
+        }
+    }
+}
+
+namespace
+{
+
+/// @brief Sorts the copy of the vector in descending order and checks the result
+template <template <typename...> class Sorter>
+bool sortsDescending(std::vector<int> v)
+{
+    Sorter<int, std::greater<>>::sort(v);
+    return std::is_sorted(v.begin(), v.end(), std::greater<>());
+}
+
+struct Record
+{
+    std::string name;
+    int age;
+};
+
+/// @brief Projection of the record to its age
+struct Age
+{
+    int operator()(const Record & r) const { return r.age; }
+};
+
+/// @brief Expensive key of the string, counts its calls
+struct Checksum
+{
+    static size_t calls;
+    uint64_t operator()(const std::string & s) const
+    {
+        ++calls;
+        uint64_t h = 14695981039346656037ull;
+        for (int round = 0; round < 16; ++round)
+            for (char c : s)
+                h = (h ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+        return h;
+    }
+};
+
+size_t Checksum::calls = 0;
+
+} // namespace
+
+SCENARIO( "Sort with comparator and projection", "[sort_compare]" ) {
+
+    GIVEN( "Vector with random items" ) {
+        std::vector<int> v;
+        tools::randomData<int>(v, 300, -50, 50);
+
+        WHEN( "Sort algorithms applied with descending comparator" ) {
+            THEN( "Vector becomes sorted in descending order" ) {
+                REQUIRE( sortsDescending<sort::DummySort>(v) );
+                REQUIRE( sortsDescending<sort::BubleSort>(v) );
+                REQUIRE( sortsDescending<sort::CombSort>(v) );
+                REQUIRE( sortsDescending<sort::ShakeSort>(v) );
+                REQUIRE( sortsDescending<sort::QuickSort>(v) );
+                REQUIRE( sortsDescending<sort::QuickSortM>(v) );
+                REQUIRE( sortsDescending<sort::Quick3Sort>(v) );
+                REQUIRE( sortsDescending<sort::GnomeSort>(v) );
+                REQUIRE( sortsDescending<sort::SelectionSort>(v) );
+                REQUIRE( sortsDescending<sort::HeapSort>(v) );
+                REQUIRE( sortsDescending<sort::InsertionSort>(v) );
+                REQUIRE( sortsDescending<sort::ShellSort>(v) );
+                REQUIRE( sortsDescending<sort::MergeSort>(v) );
+                REQUIRE( sortsDescending<sort::MergeUpSort>(v) );
+                REQUIRE( sortsDescending<sort::PowerSort>(v) );
+                REQUIRE( sortsDescending<sort::QuickInsSort>(v) );
+                REQUIRE( sortsDescending<sort::PdqSort>(v) );
+                REQUIRE( sortsDescending<sort::MergeInsSort>(v) );
+                REQUIRE( sortsDescending<sort::InsertionBinarySort>(v) );
+                REQUIRE( sortsDescending<sort::ParallelMergeSort>(v) );
+                REQUIRE( sortsDescending<sort::ParallelQuickSort>(v) );
+            }
+        }
+    }
+    GIVEN( "Vector of records" ) {
+        std::vector<Record> v;
+        for (int i = 0; i < 1000; ++i)
+            v.push_back({"name" + std::to_string(i), i * 7919 % 90});
+
+        WHEN( "Sort algorithm applied with projection to the field" ) {
+            sort::PowerSort<Record, std::less<>, Age>::sort(v);
+            THEN( "Records become sorted by the field, equal records keep the order" ) {
+                REQUIRE( std::is_sorted(v.begin(), v.end(), [](const Record & a, const Record & b) { return a.age < b.age; }) );
+                for (size_t i = 1; i < v.size(); ++i)
+                {
+                    if (v[i - 1].age == v[i].age)
+                        REQUIRE( std::stoi(v[i - 1].name.substr(4)) < std::stoi(v[i].name.substr(4)) );
+                }
+            }
+        }
+    }
+    GIVEN( "Vector of records with equal keys" ) {
+        std::vector<Record> v;
+        for (int i = 0; i < 200; ++i)
+            v.push_back({"name" + std::to_string(i), i * 7919 % 10});
+        auto byAge = [](const Record & a, const Record & b) { return a.age < b.age; };
+
+        WHEN( "Exchanging sort algorithms applied with projection to the field" ) {
+            std::vector<Record> dummy = v;
+            std::vector<Record> buble = v;
+            std::vector<Record> shake = v;
+            std::vector<Record> selection = v;
+            sort::DummySort<Record, std::less<>, Age>::sort(dummy);
+            sort::BubleSort<Record, std::less<>, Age>::sort(buble);
+            sort::ShakeSort<Record, std::less<>, Age>::sort(shake);
+            sort::SelectionSort<Record, std::less<>, Age>::sort(selection);
+            THEN( "Records become sorted by the field" ) {
+                REQUIRE( std::is_sorted(dummy.begin(), dummy.end(), byAge) );
+                REQUIRE( std::is_sorted(buble.begin(), buble.end(), byAge) );
+                REQUIRE( std::is_sorted(shake.begin(), shake.end(), byAge) );
+                REQUIRE( std::is_sorted(selection.begin(), selection.end(), byAge) );
+            }
+        }
+    }
+    GIVEN( "Vector of records and the sort column chosen at run time" ) {
+        std::vector<Record> v;
+        for (int i = 0; i < 1000; ++i)
+            v.push_back({"name" + std::to_string(i * 7919 % 1000), i * 7919 % 90});
+        const bool descending = true;
+        auto direction = [descending](int a, int b) { return descending ? b < a : a < b; };
+        auto age = [](const Record & r) { return r.age; };
+
+        WHEN( "Bound sort applied with lambdas" ) {
+            std::vector<Record> names = v;
+            std::deque<Record> ages(v.begin(), v.end());
+            sort::bindSort<Record>([](const std::string & a, const std::string & b) { return a < b; },
+                                   [](const Record & r) -> const std::string & { return r.name; }).sort(names);
+            sort::bindSort<Record, sort::MergeSort>(direction, age).sort(ages.begin(), ages.end());
+            THEN( "Records become sorted by the column in the direction, equal records keep the order" ) {
+                REQUIRE( std::is_sorted(names.begin(), names.end(), [](const Record & a, const Record & b) { return a.name < b.name; }) );
+                std::vector<Record> expected = v;
+                std::stable_sort(expected.begin(), expected.end(), [](const Record & a, const Record & b) { return b.age < a.age; });
+                REQUIRE( std::equal(ages.begin(), ages.end(), expected.begin(),
+                                    [](const Record & a, const Record & b) { return a.name == b.name && a.age == b.age; }) );
+            }
+        }
+    }
+    GIVEN( "Vector of strings with expensive keys" ) {
+        std::vector<std::string> v;
+        for (int i = 0; i < 2000; ++i)
+            v.push_back(std::to_string(i * 7919 % 500));
+
+        WHEN( "Keyed sort algorithm applied" ) {
+            Checksum::calls = 0;
+            sort::KeyedSort<std::string, Checksum>::sort(v);
+            THEN( "Vector becomes sorted by the key, every key is computed once" ) {
+                REQUIRE( Checksum::calls == v.size() );
+                for (size_t i = 1; i < v.size(); ++i)
+                    REQUIRE_FALSE( Checksum()(v[i]) < Checksum()(v[i - 1]) );
+            }
+        }
+        WHEN( "Keyed sort algorithm applied in descending order" ) {
+            sort::KeyedSort<std::string, Checksum, sort::MergeSort, std::greater<>>::sort(v);
+            THEN( "Vector becomes sorted by the key in descending order" ) {
+                for (size_t i = 1; i < v.size(); ++i)
+                    REQUIRE_FALSE( Checksum()(v[i - 1]) < Checksum()(v[i]) );
+            }
+        }
+    }
+}
+
+SCENARIO( "Sorting network for small arrays", "[sort_network]" ) {
+
+    GIVEN( "Small arrays of every length" ) {
+        WHEN( "Sorting network applied" ) {
+            THEN( "Arrays become sorted" ) {
+                for (size_t length = 0; length <= sort::SortingNetwork<int>::SIZE; ++length)
+                {
+                    for (int seed = 0; seed < 50; ++seed)
+                    {
+                        std::vector<int> i;
+                        std::vector<double> d;
+                        std::vector<uint64_t> u;
+                        std::vector<std::string> s;
+                        for (size_t k = 0; k < length; ++k)
+                        {
+                            int x = static_cast<int>((k * 7919 + static_cast<size_t>(seed) * 104729) % 23) - 11;
+                            i.push_back(x);
+                            d.push_back(seed % 5 ? x * 0.5 : std::numeric_limits<double>::infinity());
+                            u.push_back(seed % 3 ? static_cast<uint64_t>(x + 11) : std::numeric_limits<uint64_t>::max());
+                            s.push_back(std::to_string(x));
+                        }
+                        sort::SortingNetwork<int>::sort(i.data(), i.size());
+                        sort::SortingNetwork<double>::sort(d.data(), d.size());
+                        sort::SortingNetwork<uint64_t>::sort(u.data(), u.size());
+                        sort::SortingNetwork<std::string>::sort(s.data(), s.size());
+                        REQUIRE( tools::isSorted(i) );
+                        REQUIRE( tools::isSorted(d) );
+                        REQUIRE( tools::isSorted(u) );
+                        REQUIRE( tools::isSorted(s) );
+                    }
+                }
+            }
+        }
+    }
+    GIVEN( "Vector of random doubles" ) {
+        std::vector<double> v;
+        for (int k = 0; k < 10000; ++k)
+            v.push_back((k * 7919 % 10007) * -0.25);
+        std::vector<double> expected = v;
+        std::sort(expected.begin(), expected.end());
+
+        WHEN( "QuickIns sort algorithm applied" ) {
+            sort::QuickInsSort<double>::sort(v);
+            THEN( "Vector becomes sorted" ) { REQUIRE( v == expected ); }
+        }
+        WHEN( "MergeIns sort algorithm applied" ) {
+            sort::MergeInsSort<double>::sort(v);
+            THEN( "Vector becomes sorted" ) { REQUIRE( v == expected ); }
+        }
+    }
+}
+
+SCENARIO( "Merge sorts with the reusable scratch buffer", "[sort_merge]" ) {
+
+    GIVEN( "Vectors of strings of different sizes and one buffer" ) {
+        std::vector<std::vector<std::string>> inputs;
+        for (int length : {0, 1, 2, 15, 17, 100, 1000, 3001})
+        {
+            std::vector<std::string> v;
+            for (int i = 0; i < length; ++i)
+                v.push_back(std::to_string(i * 7919 % 613) + "item");
+            inputs.push_back(v);
+        }
+        std::vector<std::string> buffer;
+        buffer.reserve(3001);
+        const std::string * memory = buffer.data();
+
+        WHEN( "Merge sort algorithm applied" ) {
+            THEN( "Vectors become sorted, buffer memory is reused" ) {
+                for (auto & v : inputs)
+                {
+                    sort::MergeSort<std::string>::sort(v, buffer);
+                    REQUIRE( tools::isSorted(v) );
+                }
+                REQUIRE( buffer.data() == memory );
+            }
+        }
+        WHEN( "MergeUp sort algorithm applied" ) {
+            THEN( "Vectors become sorted, buffer memory is reused" ) {
+                for (auto & v : inputs)
+                {
+                    sort::MergeUpSort<std::string>::sort(v, buffer);
+                    REQUIRE( tools::isSorted(v) );
+                }
+                REQUIRE( buffer.data() == memory );
+            }
+        }
+        WHEN( "MergeIns sort algorithm applied" ) {
+            THEN( "Vectors become sorted, buffer memory is reused" ) {
+                for (auto & v : inputs)
+                {
+                    sort::MergeInsSort<std::string>::sort(v, buffer);
+                    REQUIRE( tools::isSorted(v) );
+                }
+                REQUIRE( buffer.data() == memory );
+            }
+        }
+    }
+    GIVEN( "Items with equal keys" ) {
+        std::vector<Event> v;
+        for (int i = 0; i < 2000; ++i)
+            v.push_back({i * 7919 % 50, i});
+        std::vector<Event> expected = v;
+        std::stable_sort(expected.begin(), expected.end());
+
+        WHEN( "Merge sort algorithms applied" ) {
+            std::vector<Event> up = v;
+            std::vector<Event> buffer;
+            sort::MergeSort<Event>::sort(v, buffer);
+            sort::MergeUpSort<Event>::sort(up, buffer);
+            THEN( "Equal items keep the order" ) {
+                REQUIRE( v == expected );
+                REQUIRE( up == expected );
+            }
+        }
+    }
+}
+
+SCENARIO( "Power sort of presorted runs", "[sort_power]" ) {
+
+    GIVEN( "Concatenation of sorted chunks" ) {
+        const int chunks = 16;
+        const int chunkLength = 4000;
+        std::vector<Event> v;
+        for (int c = 0; c < chunks; ++c)
+        {
+            for (int i = 0; i < chunkLength; ++i)
+            {
+                int key = c % 2 ? (chunkLength - i) * 3 : i * 5 + c;   // odd chunks are descending
+                v.push_back({key, static_cast<int>(v.size())});
+            }
+        }
+        std::vector<Event> expected = v;
+        std::stable_sort(expected.begin(), expected.end());
+
+        WHEN( "Power sort algorithm applied" ) {
+            Event::comparisons = 0;
+            sort::PowerSort<Event>::sort(v);
+            THEN( "Vector becomes sorted, equal items keep the order" ) {
+                REQUIRE( v == expected );
+            }
+            THEN( "Comparisons are near linear" ) {
+                REQUIRE( Event::comparisons < v.size() * 6 );
+            }
+        }
+    }
+    GIVEN( "Interleaved sorted runs of equal length" ) {
+        const int runs = 64;
+        const int runLength = 500;
+        std::vector<Event> v;
+        for (int r = 0; r < runs; ++r)
+        {
+            for (int i = 0; i < runLength; ++i)
+                v.push_back({i * runs + r, static_cast<int>(v.size())});
+        }
+
+        WHEN( "Power sort algorithm applied" ) {
+            Event::comparisons = 0;
+            sort::PowerSort<Event>::sort(v);
+            const size_t comparisons = Event::comparisons;
+            THEN( "Runs are merged by the balanced tree: log2(runs) merge levels plus the run detection" ) {
+                REQUIRE( std::is_sorted(v.begin(), v.end()) );
+                REQUIRE( comparisons < v.size() * 7 );
+            }
+        }
+    }
+    GIVEN( "Random items with many duplicates" ) {
+        std::vector<int> keys;
+        tools::randomData<int>(keys, 50000, 0, 100);
+        std::vector<Event> v;
+        for (size_t i = 0; i < keys.size(); ++i)
+            v.push_back({keys[i], static_cast<int>(i)});
+        std::vector<Event> expected = v;
+        std::stable_sort(expected.begin(), expected.end());
+
+        WHEN( "Power sort algorithm applied" ) {
+            sort::PowerSort<Event>::sort(v);
+            THEN( "Vector becomes sorted, equal items keep the order" ) { REQUIRE( v == expected ); }
+        }
+    }
+}
+
+SCENARIO( "External sort of the file", "[sort_external]" ) {
+    const std::string input = tools::temporaryFile("external_sort_input");
+    const std::string output = tools::temporaryFile("external_sort_output");
+
+    GIVEN( "File of records bigger than the memory budget" ) {
+        std::vector<Event> records;
+        for (int i = 0; i < 100000; ++i)
+            records.push_back({i * 7919 % 5000, i});
+        {
+            std::ofstream file(input, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char *>(records.data()), static_cast<std::streamsize>(records.size() * sizeof(Event)));
+        }
+        std::stable_sort(records.begin(), records.end());
+
+        auto readOutput = [&output]()
+        {
+            std::ifstream file(output, std::ios::binary | std::ios::ate);
+            std::vector<Event> result(static_cast<size_t>(file.tellg()) / sizeof(Event));
+            file.seekg(0);
+            file.read(reinterpret_cast<char *>(result.data()), static_cast<std::streamsize>(result.size() * sizeof(Event)));
+            return result;
+        };
+
+        WHEN( "External sort applied with one merge pass" ) {
+            sort::ExternalSort<Event, sort::PowerSort> sorter(512 * 1024);
+            sorter.sort(input, output);
+            THEN( "Output is sorted, equal records keep the order" ) {
+                REQUIRE( sorter.runs() == 4 );
+                REQUIRE( sorter.passes() == 1 );
+                REQUIRE( readOutput() == records );
+            }
+        }
+        WHEN( "External sort applied with small budget and parallel runs" ) {
+            tools::TaskPool pool(3);
+            sort::ExternalSort<Event, sort::PowerSort> sorter(32 * 1024, &pool);
+            sorter.sort(input, output);
+            THEN( "Output is sorted in several merge passes, equal records keep the order" ) {
+                REQUIRE( sorter.runs() > 7 );
+                REQUIRE( sorter.passes() > 1 );
+                REQUIRE( readOutput() == records );
+            }
+        }
+        WHEN( "External sort applied with few open runs allowed" ) {
+            sort::ExternalSort<Event, sort::PowerSort> sorter(32 * 1024, nullptr, 16, ".");
+            sorter.sort(input, output);
+            THEN( "Runs are merged as they are made, equal records keep the order" ) {
+                REQUIRE( sorter.runs() > 20 );
+                REQUIRE( sorter.passes() > 3 );
+                REQUIRE( readOutput() == records );
+            }
+        }
+        WHEN( "Directory of the temporary files does not exist" ) {
+            sort::ExternalSort<Event, sort::PowerSort> sorter(32 * 1024, nullptr, 0, "external_sort_missing_directory");
+            THEN( "Exception is thrown" ) { REQUIRE_THROWS_AS( sorter.sort(input, output), std::runtime_error ); }
+        }
+        WHEN( "External sort applied to the file itself" ) {
+            sort::ExternalSort<Event, sort::MergeSort> sorter(64 * 1024);
+            sorter.sort(input, input);
+            std::rename(input.c_str(), output.c_str());
+            THEN( "File becomes sorted" ) { REQUIRE( readOutput() == records ); }
+        }
+        std::remove(input.c_str());
+        std::remove(output.c_str());
+    }
+    GIVEN( "Empty file and file with a broken record" ) {
+        {
+            std::ofstream file(input, std::ios::binary | std::ios::trunc);
+        }
+        WHEN( "External sort applied" ) {
+            sort::ExternalSort<uint64_t> sorter;
+            sorter.sort(input, output);
+            std::ifstream file(output, std::ios::binary | std::ios::ate);
+            THEN( "Output is empty" ) { REQUIRE( file.tellg() == 0 ); }
+        }
+        WHEN( "Size of the file is not multiple of the record size" ) {
+            {
+                std::ofstream file(input, std::ios::binary | std::ios::trunc);
+                file.write("abc", 3);
+            }
+            sort::ExternalSort<uint64_t> sorter;
+            THEN( "Exception is thrown" ) { REQUIRE_THROWS_AS( sorter.sort(input, output), std::runtime_error ); }
+        }
+#ifdef __linux__
+        WHEN( "Output can not be written" ) {
+            {
+                std::ofstream file(input, std::ios::binary | std::ios::trunc);
+                const uint64_t records[] = {3, 1, 2};
+                file.write(reinterpret_cast<const char *>(records), sizeof(records));
+            }
+            sort::ExternalSort<uint64_t> sorter;
+            THEN( "Exception is thrown" ) { REQUIRE_THROWS_AS( sorter.sort(input, "/dev/full"), std::runtime_error ); }
+        }
+#endif
+        std::remove(input.c_str());
+        std::remove(output.c_str());
+    }
+}
+
+SCENARIO( "Pdq sort of patterned data", "[sort_pdq]" ) {
+
+    GIVEN( "Vectors with patterns which break naive quick sorts" ) {
+        const int length = 100000;
+        std::vector<std::vector<int>> inputs(8);
+        for (int i = 0; i < length; ++i)
+        {
+            inputs[0].push_back(i);                                  // sorted
+            inputs[1].push_back(length - i);                         // reversed
+            inputs[2].push_back(i < length / 2 ? i : length - i);    // organ pipe
+            inputs[3].push_back(7);                                  // equal
+            inputs[4].push_back(i % 100);                            // sawtooth
+            inputs[5].push_back(i % 1000 == 0 ? -i : i);             // nearly sorted
+            inputs[6].push_back(i % 2 ? i : length - i);             // interleaved
+        }
+        tools::randomData<int>(inputs[7], length, 0, 1000);          // many duplicates
+
+        WHEN( "Pdq sort algorithm applied" ) {
+            THEN( "Vectors become sorted" ) {
+                for (auto & v : inputs)
+                {
+                    std::vector<int> expected = v;
+                    std::sort(expected.begin(), expected.end());
+                    sort::PdqSort<int>::sort(v);
+                    REQUIRE( v == expected );
+                }
+            }
+        }
+    }
+    GIVEN( "Vector of strings" ) {
+        std::vector<std::string> v;
+        for (int i = 0; i < 5000; ++i)
+            v.push_back(std::to_string(i * 7919 % 3000));
+        std::vector<std::string> expected = v;
+        std::sort(expected.begin(), expected.end());
+
+        WHEN( "Pdq sort algorithm applied" ) {
+            sort::PdqSort<std::string>::sort(v);
+            THEN( "Vector becomes sorted" ) { REQUIRE( v == expected ); }
+        }
+    }
+}
+
+SCENARIO( "Radix sort of numbers and strings", "[sort_radix]" ) {
+
+    GIVEN( "Vector of 64-bit ids with negative values" ) {
+        std::vector<int64_t> v;
+        tools::randomData<int64_t>(v, 100000, std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max());
+        for (int64_t i = -1000; i < 1000; ++i)
+            v.push_back(i);
+        std::vector<int64_t> expected = v;
+        std::sort(expected.begin(), expected.end());
+
+        WHEN( "LsdRadix sort algorithm applied" ) {
+            sort::LsdRadixSort<int64_t>::sort(v);
+            THEN( "Vector becomes sorted" ) { REQUIRE( v == expected ); }
+        }
+        WHEN( "LsdRadix sort algorithm applied in parallel" ) {
+            tools::TaskPool pool(3);
+            sort::LsdRadixSort<int64_t>::sort(v, pool);
+            THEN( "Vector becomes sorted" ) { REQUIRE( v == expected ); }
+        }
+        WHEN( "AmericanFlag sort algorithm applied" ) {
+            sort::AmericanFlagSort<int64_t>::sort(v);
+            THEN( "Vector becomes sorted" ) { REQUIRE( v == expected ); }
+        }
+    }
+    GIVEN( "Vector of small unsigned numbers" ) {
+        std::vector<uint64_t> v;
+        tools::randomData<uint64_t>(v, 5000, 0, 300);
+        std::vector<uint64_t> expected = v;
+        std::sort(expected.begin(), expected.end());
+
+        WHEN( "LsdRadix sort algorithm applied" ) {
+            sort::LsdRadixSort<uint64_t>::sort(v);
+            THEN( "Vector becomes sorted" ) { REQUIRE( v == expected ); }
+        }
+        WHEN( "AmericanFlag sort algorithm applied" ) {
+            sort::AmericanFlagSort<uint64_t>::sort(v);
+            THEN( "Vector becomes sorted" ) { REQUIRE( v == expected ); }
+        }
+    }
+    GIVEN( "Vector of floats and doubles" ) {
+        std::vector<double> d;
+        std::vector<float> f;
+        for (int i = 0; i < 20000; ++i)
+        {
+            double x = (i * 7919 % 20000 - 10000) * 0.37;
+            d.push_back(x);
+            f.push_back(static_cast<float>(-x * 1e-3));
+        }
+        d.push_back(std::numeric_limits<double>::infinity());
+        d.push_back(-std::numeric_limits<double>::infinity());
+        d.push_back(std::numeric_limits<double>::lowest());
+        std::vector<double> expectedD = d;
+        std::sort(expectedD.begin(), expectedD.end());
+        std::vector<float> expectedF = f;
+        std::sort(expectedF.begin(), expectedF.end());
+
+        WHEN( "LsdRadix sort algorithm applied" ) {
+            sort::LsdRadixSort<double>::sort(d);
+            sort::LsdRadixSort<float>::sort(f);
+            THEN( "Vectors become sorted" ) {
+                REQUIRE( d == expectedD );
+                REQUIRE( f == expectedF );
+            }
+        }
+        WHEN( "AmericanFlag sort algorithm applied" ) {
+            sort::AmericanFlagSort<double>::sort(d);
+            sort::AmericanFlagSort<float>::sort(f);
+            THEN( "Vectors become sorted" ) {
+                REQUIRE( d == expectedD );
+                REQUIRE( f == expectedF );
+            }
+        }
+    }
+    GIVEN( "Vector of strings with common prefixes" ) {
+        std::vector<std::string> v;
+        for (int i = 0; i < 5000; ++i)
+        {
+            int k = i * 7919 % 5000;
+            v.push_back(std::string(static_cast<size_t>(k % 7), 'a') + std::to_string(k % 1000) + (k % 3 ? "\xff" : ""));
+        }
+        v.push_back("");
+        v.push_back("");
+        std::vector<std::string> expected = v;
+        std::sort(expected.begin(), expected.end());
+
+        WHEN( "MsdRadix sort algorithm applied" ) {
+            sort::MsdRadixSort<std::string>::sort(v);
+            THEN( "Vector becomes sorted" ) { REQUIRE( v == expected ); }
+        }
+    }
+}
+
+
+namespace
+{
+
+/// @brief Sorts the middle of the copy of the vector by iterators and checks the result
+template <template <typename...> class Sorter>
+bool sortsRange(std::vector<int> v)
+{
+    const std::vector<int> original = v;
+    Sorter<int>::sort(v.begin() + 10, v.end() - 10);
+    return std::is_sorted(v.begin() + 10, v.end() - 10)
+        && std::equal(v.begin(), v.begin() + 10, original.begin())
+        && std::equal(v.end() - 10, v.end(), original.end() - 10)
+        && std::is_permutation(v.begin(), v.end(), original.begin());
+}
+
+/// @brief Sorts the copy of the vector as the array and as the deque, checks empty ranges too
+template <template <typename...> class Sorter>
+bool sortsArrayAndDeque(const std::vector<int> & v)
+{
+    std::unique_ptr<int[]> array(new int[v.size()]);
+    std::copy(v.begin(), v.end(), array.get());
+    Sorter<int>::sort(array.get(), v.size());
+
+    std::deque<int> d(v.begin(), v.end());
+    Sorter<int>::sort(d.begin(), d.end());
+
+    Sorter<int>::sort(array.get(), size_t(0));
+    Sorter<int>::sort(d.end(), d.end());
+    return std::is_sorted(array.get(), array.get() + v.size()) && std::is_sorted(d.begin(), d.end());
+}
+
+} // namespace
+
+SCENARIO( "Sort ranges of iterators and arrays", "[sort_range]" ) {
+
+    GIVEN( "Vector with random items" ) {
+        std::vector<int> v;
+        tools::randomData<int>(v, 300, -50, 50);
+
+        WHEN( "Sort algorithms applied to the middle of the vector" ) {
+            THEN( "Only the middle becomes sorted" ) {
+                REQUIRE( sortsRange<sort::DummySort>(v) );
+                REQUIRE( sortsRange<sort::BubleSort>(v) );
+                REQUIRE( sortsRange<sort::CombSort>(v) );
+                REQUIRE( sortsRange<sort::ShakeSort>(v) );
+                REQUIRE( sortsRange<sort::QuickSort>(v) );
+                REQUIRE( sortsRange<sort::QuickSortM>(v) );
+                REQUIRE( sortsRange<sort::Quick3Sort>(v) );
+                REQUIRE( sortsRange<sort::GnomeSort>(v) );
+                REQUIRE( sortsRange<sort::SelectionSort>(v) );
+                REQUIRE( sortsRange<sort::HeapSort>(v) );
+                REQUIRE( sortsRange<sort::InsertionSort>(v) );
+                REQUIRE( sortsRange<sort::ShellSort>(v) );
+                REQUIRE( sortsRange<sort::MergeSort>(v) );
+                REQUIRE( sortsRange<sort::MergeUpSort>(v) );
+                REQUIRE( sortsRange<sort::PowerSort>(v) );
+                REQUIRE( sortsRange<sort::QuickInsSort>(v) );
+                REQUIRE( sortsRange<sort::PdqSort>(v) );
+                REQUIRE( sortsRange<sort::MergeInsSort>(v) );
+                REQUIRE( sortsRange<sort::InsertionBinarySort>(v) );
+                REQUIRE( sortsRange<sort::ParallelMergeSort>(v) );
+                REQUIRE( sortsRange<sort::ParallelQuickSort>(v) );
+                REQUIRE( sortsRange<sort::LsdRadixSort>(v) );
+                REQUIRE( sortsRange<sort::AmericanFlagSort>(v) );
+            }
+        }
+        WHEN( "Sort algorithms applied to the array and to the deque" ) {
+            THEN( "Both become sorted" ) {
+                REQUIRE( sortsArrayAndDeque<sort::DummySort>(v) );
+                REQUIRE( sortsArrayAndDeque<sort::ShakeSort>(v) );
+                REQUIRE( sortsArrayAndDeque<sort::QuickSort>(v) );
+                REQUIRE( sortsArrayAndDeque<sort::Quick3Sort>(v) );
+                REQUIRE( sortsArrayAndDeque<sort::HeapSort>(v) );
+                REQUIRE( sortsArrayAndDeque<sort::ShellSort>(v) );
+                REQUIRE( sortsArrayAndDeque<sort::MergeUpSort>(v) );
+                REQUIRE( sortsArrayAndDeque<sort::PowerSort>(v) );
+                REQUIRE( sortsArrayAndDeque<sort::PdqSort>(v) );
+                REQUIRE( sortsArrayAndDeque<sort::MergeInsSort>(v) );
+                REQUIRE( sortsArrayAndDeque<sort::ParallelMergeSort>(v) );
+                REQUIRE( sortsArrayAndDeque<sort::ParallelQuickSort>(v) );
+                REQUIRE( sortsArrayAndDeque<sort::LsdRadixSort>(v) );
+                REQUIRE( sortsArrayAndDeque<sort::AmericanFlagSort>(v) );
+            }
+        }
+    }
+    GIVEN( "Array of strings" ) {
+        std::string a[] = {"pear", "apple", "fig", "", "banana", "apple", "cherry"};
+
+        WHEN( "MsdRadix and Keyed sort algorithms applied to the array" ) {
+            sort::MsdRadixSort<std::string>::sort(a, 4);
+            sort::KeyedSort<std::string, sort::Identity>::sort(std::begin(a) + 4, std::end(a));
+            THEN( "Both parts become sorted" ) {
+                REQUIRE( std::is_sorted(a, a + 4) );
+                REQUIRE( std::is_sorted(a + 4, a + 7) );
+            }
+        }
+    }
+}
+
+
+namespace
+{
+
+/// @brief Selects the element k of the copy of the vector and checks the result
+template <template <typename...> class Selector>
+bool selects(std::vector<int> v, size_t k)
+{
+    std::vector<int> expected = v;
+    std::sort(expected.begin(), expected.end());
+    Selector<int>::select(v, k);
+    if (v[k] != expected[k])
+        return false;
+    for (size_t i = 0; i < v.size(); ++i)
+    {
+        if ((i < k && v[k] < v[i]) || (i > k && v[i] < v[k]))
+            return false;
+    }
+    return true;
+}
+
+} // namespace
+
+SCENARIO( "Selection of the k-th and the top-k elements", "[sort_select]" ) {
+
+    GIVEN( "Vector with random items and duplicates" ) {
+        std::vector<int> v;
+        tools::randomData<int>(v, 20000, -1000, 1000);
+        std::vector<int> expected = v;
+        std::sort(expected.begin(), expected.end());
+
+        WHEN( "Select algorithms applied" ) {
+            THEN( "The element k gets to its place" ) {
+                for (size_t k : {size_t(0), size_t(1), size_t(777), size_t(10000), size_t(19999)})
+                {
+                    REQUIRE( selects<sort::QuickSelect>(v, k) );
+                    REQUIRE( selects<sort::FloydRivestSelect>(v, k) );
+                }
+            }
+        }
+        WHEN( "Select algorithm applied to the deque" ) {
+            std::deque<int> d(v.begin(), v.end());
+            sort::FloydRivestSelect<int>::select(d.begin(), d.begin() + 5000, d.end());
+            THEN( "The element gets to its place" ) { REQUIRE( d[5000] == expected[5000] ); }
+        }
+        WHEN( "Partial sort algorithm applied" ) {
+            sort::PartialSort<int>::sort(v, 100);
+            THEN( "The least elements become sorted at the beginning" ) {
+                REQUIRE( std::equal(v.begin(), v.begin() + 100, expected.begin()) );
+                std::sort(v.begin() + 100, v.end());
+                REQUIRE( v == expected );
+            }
+        }
+        WHEN( "Partial sort algorithm applied to the whole vector" ) {
+            sort::PartialSort<int>::sort(v.begin(), v.end(), v.end());
+            THEN( "Vector becomes sorted" ) { REQUIRE( v == expected ); }
+        }
+        WHEN( "Top-k of the stream is collected in descending order" ) {
+            sort::TopK<int, std::greater<>> top(100);
+            top.push(v.begin(), v.end());
+            std::vector<int> best = top.sorted();
+            THEN( "The greatest elements are kept" ) {
+                REQUIRE( top.size() == 100 );
+                REQUIRE( top.top() == expected[expected.size() - 100] );
+                REQUIRE( std::equal(best.begin(), best.end(), expected.rbegin()) );
+            }
+        }
+    }
+    GIVEN( "Sorted vector and vector of equal items" ) {
+        std::vector<int> sorted(50000);
+        for (size_t i = 0; i < sorted.size(); ++i)
+            sorted[i] = static_cast<int>(i);
+        std::vector<int> equal(50000, 7);
+
+        WHEN( "Select algorithms applied" ) {
+            THEN( "The element k gets to its place" ) {
+                REQUIRE( selects<sort::QuickSelect>(sorted, 25000) );
+                REQUIRE( selects<sort::FloydRivestSelect>(sorted, 25000) );
+                REQUIRE( selects<sort::QuickSelect>(equal, 100) );
+                REQUIRE( selects<sort::FloydRivestSelect>(equal, 100) );
+            }
+        }
+    }
+    GIVEN( "Small and empty tops" ) {
+        sort::TopK<int> none(0);
+        sort::TopK<int> few(10);
+        for (int i = 5; i > 0; --i)
+        {
+            none.push(i);
+            few.push(i);
+        }
+        THEN( "All elements are kept while the top is not full" ) {
+            REQUIRE( none.empty() );
+            REQUIRE( few.sorted() == std::vector<int>({1, 2, 3, 4, 5}) );
+        }
     }
 }
 
@@ -6,7 +6,10 @@
 //--------------------------------------------------------------------------------------------------
 #include "catch2/catch.hpp"
 #include "UnionFind.hpp"
+#include "UnionFindConcurrent.hpp"
 #include "Tools.hpp"
+
+#include <thread>
 //--------------------------------------------------------------------------------------------------
 
 namespace tests
@@ -89,4 +92,128 @@ SCENARIO( "Union-find testing", "[union_find]" ) {
     }
 }
 
+SCENARIO( "Compact union-find testing", "[union_find]" ) {
+    GIVEN( "UnionFind compact struct" ) {
+        uf::UnionFindCompactInfo<> ufData{10};
+        uf::UnionFind_Compact<> unionFind;
+        unionFind.unionComponents(ufData, 1, 3);
+        unionFind.unionComponents(ufData, 2, 8);
+        unionFind.unionComponents(ufData, 1, 7);
+        unionFind.unionComponents(ufData, 3, 9);
+        unionFind.unionComponents(ufData, 4, 8);
+
+        WHEN( "Components are united" ) {
+            THEN( "Their clusters and sizes can be found" ) {
+                REQUIRE( static_cast<uint32_t>(1) == unionFind.find(ufData, 9) );
+                REQUIRE( static_cast<uint32_t>(2) == unionFind.find(ufData, 4) );
+                REQUIRE( static_cast<uint32_t>(6) == unionFind.find(ufData, 6) );
+                REQUIRE( static_cast<uint32_t>(4) == unionFind.clasterSize(ufData, 7) );
+                REQUIRE( static_cast<uint32_t>(5) == ufData.clasters );
+            }
+        }
+        WHEN( "Given UnionFindCompactInfo" ) {
+            THEN( "Check componets are connected" ) {
+                REQUIRE( unionFind.connected(ufData, 7, 3) );
+                REQUIRE( unionFind.connected(ufData, 4, 2) );
+                REQUIRE_FALSE( unionFind.connected(ufData, 1, 2) );
+                REQUIRE_FALSE( unionFind.unionComponents(ufData, 9, 7) );
+            }
+        }
+        WHEN( "Too many elements are requested" ) {
+            THEN( "Exception is thrown" ) {
+                REQUIRE_THROWS_AS( uf::UnionFindCompactInfo<uint16_t>{40000}, std::length_error );
+            }
+        }
+    }
+}
+
+SCENARIO( "Rollback union-find testing", "[union_find]" ) {
+    GIVEN( "UnionFind struct with rollback" ) {
+        uf::UnionFindRollbackInfo<size_t> ufData{10};
+        uf::UnionFind_Rollback<size_t> unionFind;
+        unionFind.unionComponents(ufData, 1, 3);
+        unionFind.unionComponents(ufData, 2, 8);
+        auto checkpoint = unionFind.checkpoint(ufData);
+        unionFind.unionComponents(ufData, 1, 7);
+        unionFind.unionComponents(ufData, 3, 8);
+
+        WHEN( "Components are united" ) {
+            THEN( "Check componets are connected" ) {
+                REQUIRE( unionFind.connected(ufData, 7, 2) );
+                REQUIRE( static_cast<size_t>(6) == ufData.clasters );
+            }
+        }
+        WHEN( "Unions are rolled back" ) {
+            unionFind.rollback(ufData, checkpoint);
+            THEN( "Only unions before the checkpoint remain" ) {
+                REQUIRE( unionFind.connected(ufData, 1, 3) );
+                REQUIRE( unionFind.connected(ufData, 2, 8) );
+                REQUIRE_FALSE( unionFind.connected(ufData, 1, 7) );
+                REQUIRE_FALSE( unionFind.connected(ufData, 3, 8) );
+                REQUIRE( static_cast<size_t>(8) == ufData.clasters );
+            }
+        }
+    }
+}
+
+SCENARIO( "Concurrent union-find testing", "[union_find]" ) {
+    uf::UnionFind_Concurrent<size_t> unionFind;
+
+    GIVEN( "UnionFindConcurrentInfo united from single thread" ) {
+        uf::UnionFindConcurrentInfo<size_t> ufData{10};
+        unionFind.unionComponents(ufData, 1, 3);
+        unionFind.unionComponents(ufData, 2, 8);
+        unionFind.unionComponents(ufData, 1, 7);
+        unionFind.unionComponents(ufData, 3, 9);
+        unionFind.unionComponents(ufData, 4, 8);
+
+        WHEN( "Components are united" ) {
+            THEN( "Their clusters can be found" ) {
+                REQUIRE( unionFind.find(ufData, 9) == unionFind.find(ufData, 1) );
+                REQUIRE( unionFind.find(ufData, 2) == unionFind.find(ufData, 4) );
+                REQUIRE( static_cast<size_t>(6) == unionFind.find(ufData, 6) );
+                REQUIRE( static_cast<size_t>(5) == ufData.clasters.load() );
+            }
+        }
+        WHEN( "Given UnionFindConcurrentInfo" ) {
+            THEN( "Check componets are connected" ) {
+                REQUIRE( unionFind.connected(ufData, 7, 3) );
+                REQUIRE( unionFind.connected(ufData, 4, 2) );
+                REQUIRE_FALSE( unionFind.connected(ufData, 1, 2) );
+                REQUIRE_FALSE( unionFind.unionComponents(ufData, 9, 7) );
+            }
+        }
+    }
+    GIVEN( "UnionFindConcurrentInfo united from many threads" ) {
+        const size_t count = 10000;
+        uf::UnionFindConcurrentInfo<size_t> ufData{count};
+
+        // every thread links its own part of two chains: even and odd elements
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < 4; ++t)
+        {
+            threads.emplace_back([&ufData, t, count]() {
+                uf::UnionFind_Concurrent<size_t> threadUnionFind;
+                for (size_t i = t; i + 2 < count; i += 4)
+                {
+                    threadUnionFind.unionComponents(ufData, i, i + 2);
+                }
+            });
+        }
+        for (auto & thread : threads)
+        {
+            thread.join();
+        }
+
+        WHEN( "All threads are finished" ) {
+            THEN( "Two clusters remain" ) {
+                REQUIRE( static_cast<size_t>(2) == ufData.clasters.load() );
+                REQUIRE( unionFind.connected(ufData, 0, count - 2) );
+                REQUIRE( unionFind.connected(ufData, 1, count - 1) );
+                REQUIRE_FALSE( unionFind.connected(ufData, 0, 1) );
+            }
+        }
+    }
+}
+
 }// namespace tests
@@ -5,5 +5,6 @@
 
 //--------------------------------------------------------------------------------------------------
 #define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_NO_POSIX_SIGNALS
 #include "catch2/catch.hpp"
 //--------------------------------------------------------------------------------------------------